@@ -0,0 +1,158 @@
+#ifndef __CHECKPOINT_H
+#define __CHECKPOINT_H
+
+#include <omnetpp.h>
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <type_traits>
+
+using namespace omnetpp;
+
+/**
+ * Buffered binary snapshot stream. Values are stored in native byte order,
+ * so a checkpoint is only meant to be resumed on the machine that wrote it.
+ */
+class CheckpointWriter {
+ private:
+  std::ofstream out;
+
+ public:
+  explicit CheckpointWriter(const std::string& fileName)
+      : out(fileName, std::ios::binary | std::ios::trunc) {
+    if (!out) {
+      throw cRuntimeError("Cannot open checkpoint file %s", fileName.c_str());
+    }
+  }
+
+  template <typename T>
+  void write(const T& value) {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                  "Only plain values can be written directly");
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void write(const simtime_t& value) { write((int64_t)value.raw()); }
+
+  void write(const std::string& value) {
+    write((uint32_t)value.size());
+    out.write(value.data(), value.size());
+  }
+
+  template <typename T>
+  void write(const std::set<T>& values) {
+    write((uint32_t)values.size());
+    for (const T& value : values) write(value);
+  }
+
+  template <typename K, typename V>
+  void write(const std::map<K, V>& values) {
+    write((uint32_t)values.size());
+    for (const auto& pair : values) {
+      write(pair.first);
+      write(pair.second);
+    }
+  }
+
+  bool good() const { return out.good(); }
+};
+
+class CheckpointReader {
+ private:
+  std::ifstream in;
+
+ public:
+  explicit CheckpointReader(const std::string& fileName)
+      : in(fileName, std::ios::binary) {
+    if (!in) {
+      throw cRuntimeError("Cannot open checkpoint file %s", fileName.c_str());
+    }
+  }
+
+  template <typename T>
+  void read(T& value) {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                  "Only plain values can be read directly");
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    if (!in) throw cRuntimeError("Truncated checkpoint file");
+  }
+
+  void read(simtime_t& value) {
+    int64_t raw;
+    read(raw);
+    value.setRaw(raw);
+  }
+
+  void read(std::string& value) {
+    uint32_t size;
+    read(size);
+    value.resize(size);
+    in.read(&value[0], size);
+    if (!in) throw cRuntimeError("Truncated checkpoint file");
+  }
+
+  template <typename T>
+  void read(std::set<T>& values) {
+    uint32_t size;
+    read(size);
+    values.clear();
+    for (uint32_t i = 0; i < size; i++) {
+      T value;
+      read(value);
+      values.insert(value);
+    }
+  }
+
+  template <typename K, typename V>
+  void read(std::map<K, V>& values) {
+    uint32_t size;
+    read(size);
+    values.clear();
+    for (uint32_t i = 0; i < size; i++) {
+      K key;
+      read(key);
+      read(values[key]);
+    }
+  }
+};
+
+/**
+ * Implemented by modules whose state MISCheckpointer saves and restores.
+ * Pending events are not part of saveState(): the checkpointer collects them
+ * from the future event set and hands them back in their original order.
+ */
+class ICheckpointable {
+ public:
+  virtual ~ICheckpointable() {}
+
+  // Writes or reads every field that changes after initialize()
+  virtual void saveState(CheckpointWriter& out) = 0;
+  virtual void loadState(CheckpointReader& in) = 0;
+
+  // Maps own self-messages to stable slot numbers, -1 if not own
+  virtual int selfMessageSlot(cMessage* msg) const = 0;
+  virtual void restoreSelfMessage(int slot, simtime_t arrivalTime) = 0;
+
+  // Re-delivers a message that was in flight on the given output gate
+  virtual void restoreInFlight(cMessage* msg, int gateIndex,
+                               simtime_t arrivalTime) = 0;
+};
+
+/**
+ * Inserts a message that was in flight on outGate directly at the end of
+ * its path, arriving at the recorded time. Sending it again would add the
+ * channel delay a second time to an arrival time that already includes it.
+ */
+inline void redeliverInFlight(cMessage* msg, cGate* outGate,
+                              simtime_t arrivalTime) {
+  cGate* inGate = outGate->getPathEndGate();
+  msg->setSentFrom(outGate->getOwnerModule(), outGate->getId(), simTime());
+  msg->setArrival(inGate->getOwnerModule()->getId(), inGate->getId(),
+                  arrivalTime);
+  getSimulation()->insertEvent(msg);
+}
+
+#endif
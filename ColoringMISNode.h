@@ -0,0 +1,121 @@
+#ifndef __COLORINGMISNODE_H
+#define __COLORINGMISNODE_H
+
+#include <omnetpp.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "Checkpoint.h"
+#include "MISProgressCollector.h"
+#include "MISGraph.h"
+#include "message_m.h"
+
+using namespace omnetpp;
+
+class ColoringMISNode : public cSimpleModule,
+                        public ICheckpointable,
+                        public IMISMember {
+ public:
+  enum RoundType { COLOR_REDUCTION, BLOCK_REDUCTION, COLOR_SWEEP };
+
+  // One synchronous round of the schedule. Every node derives the same
+  // schedule from the ID space and the maximum degree.
+  struct Round {
+    RoundType type;
+    int q;              // COLOR_REDUCTION: field size
+    int d;              // COLOR_REDUCTION: polynomial degree
+    int blockSize;      // BLOCK_REDUCTION: colors per block
+    int color;          // BLOCK_REDUCTION/COLOR_SWEEP: color acting now
+    int compactBefore;  // Block size to compact colors with before acting
+  };
+
+  // Last known color of a neighbor and the round in which it was set
+  struct NeighborColor {
+    int color;
+    int round;
+  };
+
+ private:
+  int nodeId;
+  int color;
+  int colorRound;
+  int currentRound;
+  int decisionRound;
+  bool inMIS;
+  bool terminated;
+
+  // Global knowledge every node agrees on
+  int maxDegree;
+  int idSpace;
+  std::vector<Round> schedule;
+  std::vector<int> compactionRounds;
+
+  // Neighbors and their current colors
+  std::set<int> neighbors;
+  std::map<int, NeighborColor> neighborColors;
+  std::set<int> neighborsInMIS;
+
+  // Self-scheduling messages
+  cMessage* roundStartMsg;
+  cMessage* sendColorMsg;
+
+  // Timing parameters
+  double roundInterval;
+  double initialStartDelay;
+  double colorSendDelay;
+
+  // Statistics tracking
+  int totalMessagesSent;
+  int totalMessagesReceived;
+  int controlMessagesReceived;
+  simtime_t algorithmStartTime;
+  simtime_t algorithmEndTime;
+  int initialNeighborCount;
+  simsignal_t msgOverheadSignal;
+  simsignal_t convergenceTimeSignal;
+
+  // Network-level progress counters, nullptr unless sampling is enabled
+  MISProgressCollector* progress;
+
+ protected:
+  virtual int numInitStages() const override { return 2; }
+  virtual void initialize(int stage) override;
+  virtual void handleMessage(cMessage* msg) override;
+  virtual void finish() override;
+
+ public:
+  // Checkpoint support, see MISCheckpointer
+  virtual void saveState(CheckpointWriter& out) override;
+  virtual void loadState(CheckpointReader& in) override;
+  virtual int selfMessageSlot(cMessage* msg) const override;
+  virtual void restoreSelfMessage(int slot, simtime_t arrivalTime) override;
+  virtual void restoreInFlight(cMessage* msg, int gateIndex,
+                               simtime_t arrivalTime) override;
+
+  // Final MIS membership, see MISVerifier
+  virtual bool isInMIS() const override { return inMIS; }
+
+ private:
+  void computeGlobalBounds();
+  void buildSchedule();
+  simtime_t roundStartTime(int round) const;
+  int nextActiveRound(int afterRound) const;
+  int colorAtRound(int c, int fromRound, int toRound) const;
+  void startRound();
+  void reduceColor(const Round& round);
+  void reduceBlockColor(const Round& round);
+  void sweepColor(const Round& round);
+  void sendColor();
+  void joinMIS();
+  void terminate();
+  void processColorAnnouncement(MISColorAnnouncement* msg);
+  void processJoinNotification(MISJoinNotification* msg);
+  int broadcastToNeighbors(cMessage* msg);
+
+  static int compactColor(int c, int blockSize, int target);
+  static int evaluatePolynomial(int c, int q, int d, int x);
+};
+
+#endif
@@ -0,0 +1,289 @@
+#include "FastMISBatchRunner.h"
+
+#include <algorithm>
+#include <iostream>
+
+Define_Module(MISTopologyNode);
+Define_Module(FastMISBatchRunner);
+
+void FastMISBatchRunner::initialize() {
+  wallClockStart = std::chrono::steady_clock::now();
+
+  replications = par("replications");
+  phaseInterval = par("phaseInterval").doubleValue();
+  failOnViolation = par("failOnViolation").boolValue();
+  currentPhase = 0;
+
+  misSizeStats.setName("misSize");
+  phaseStats.setName("phases");
+  phaseConvergenceTimeStats.setName("phaseConvergenceTime");
+  messageOverheadStats.setName("totalMessageOverhead");
+
+  buildTopology();
+
+  // Per node state for every replication
+  size_t stateSize = (size_t)numNodes * replications;
+  status.assign(stateSize, ACTIVE);
+  randomValue.assign(stateSize, 0.0);
+  minNeighborValue.assign(stateSize, 0.0);
+
+  // Every replication draws from its own stream, seeded from the run's RNG
+  rngs.clear();
+  for (int r = 0; r < replications; r++) {
+    rngs.emplace_back((uint64_t)intuniform(0, INT32_MAX));
+  }
+  activeNodes.assign(replications, numNodes);
+  misSize.assign(replications, 0);
+  phases.assign(replications, 0);
+  messagesSent.assign(replications, 0);
+  messagesReceived.assign(replications, 0);
+  activeReplications = numNodes > 0 ? replications : 0;
+
+  phaseStartMsg = new cMessage("phaseStart");
+  if (activeReplications > 0) scheduleAt(simTime(), phaseStartMsg);
+
+  EV << "FastMISBatchRunner initialized with " << numNodes << " nodes, "
+     << graph.links() << " edges and " << replications
+     << " replications" << endl;
+}
+
+/**
+ * Reads the connection graph once from the topology nodes, numbered by
+ * their position among the submodules.
+ */
+void FastMISBatchRunner::buildTopology() {
+  graph.build<MISTopologyNode>(getParentModule());
+  numNodes = graph.size();
+}
+
+void FastMISBatchRunner::handleMessage(cMessage* msg) {
+  if (msg == phaseStartMsg) {
+    runPhase();
+    if (activeReplications > 0) {
+      scheduleAt(simTime() + phaseInterval, phaseStartMsg);
+    }
+  } else {
+    EV_WARN << "Unknown message has been received!" << endl;
+    delete msg;
+  }
+}
+
+/**
+ * One phase in every unfinished replication: active nodes exchange random
+ * values, local minima join MIS, and the join and terminate notifications
+ * are delivered like FastMISNode sends them. A terminate notification
+ * shrinks the receiver's active neighborhood and FastMISNode re-checks its
+ * decision on it, so joins cascade within the phase until no remaining
+ * active node is a local minimum of the current values.
+ */
+void FastMISBatchRunner::runPhase() {
+  currentPhase++;
+
+  exchangeRandomValues();
+  markJoiningNodes();
+
+  do {
+    // Joining nodes send a join and a terminate notification, their
+    // neighbors a terminate notification
+    notifyNeighbors(JOINING, true);
+    notifyNeighbors(JOINING, false);
+    notifyNeighbors(LEAVING, false);
+    settleDecisions();
+  } while (markCascadeJoins());
+
+  completePhase();
+}
+
+void FastMISBatchRunner::exchangeRandomValues() {
+  std::uniform_real_distribution<double> uniformValue(0.0, 1.0);
+  for (int u = 0; u < numNodes; u++) {
+    for (int r = 0; r < replications; r++) {
+      size_t i = index(u, r);
+      if (status[i] == ACTIVE) randomValue[i] = uniformValue(rngs[r]);
+      minNeighborValue[i] = 2.0;  // Above any random value
+    }
+  }
+
+  for (int u = 0; u < numNodes; u++) {
+    for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+      int v = graph.adjacency[e];
+      for (int r = 0; r < replications; r++) {
+        size_t iu = index(u, r);
+        size_t iv = index(v, r);
+        if (status[iu] != ACTIVE) continue;
+        messagesSent[r]++;
+        if (status[iv] == ACTIVE) {
+          messagesReceived[r]++;
+          minNeighborValue[iv] =
+              std::min(minNeighborValue[iv], randomValue[iu]);
+        }
+      }
+    }
+  }
+}
+
+bool FastMISBatchRunner::markJoiningNodes() {
+  bool joined = false;
+  for (size_t i = 0; i < status.size(); i++) {
+    if (status[i] == ACTIVE && randomValue[i] < minNeighborValue[i]) {
+      status[i] = JOINING;
+      joined = true;
+    }
+  }
+  return joined;
+}
+
+/**
+ * Re-checks the remaining active nodes against the values of their still
+ * active neighbors, without new messages: every one of them already
+ * received these values earlier in the phase.
+ */
+bool FastMISBatchRunner::markCascadeJoins() {
+  std::fill(minNeighborValue.begin(), minNeighborValue.end(), 2.0);
+
+  for (int u = 0; u < numNodes; u++) {
+    for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+      int v = graph.adjacency[e];
+      for (int r = 0; r < replications; r++) {
+        size_t iu = index(u, r);
+        size_t iv = index(v, r);
+        if (status[iu] == ACTIVE && status[iv] == ACTIVE) {
+          minNeighborValue[iv] =
+              std::min(minNeighborValue[iv], randomValue[iu]);
+        }
+      }
+    }
+  }
+
+  return markJoiningNodes();
+}
+
+/**
+ * Delivers one broadcast from every node in the given status. Active
+ * receivers count the message, and a join notification makes them leave.
+ * Terminated receivers drop it, as in FastMISNode.
+ */
+void FastMISBatchRunner::notifyNeighbors(uint8_t sender, bool coverNeighbors) {
+  for (int u = 0; u < numNodes; u++) {
+    for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+      int v = graph.adjacency[e];
+      for (int r = 0; r < replications; r++) {
+        size_t iu = index(u, r);
+        size_t iv = index(v, r);
+        if (status[iu] != sender) continue;
+        messagesSent[r]++;
+        if (status[iv] == ACTIVE) {
+          messagesReceived[r]++;
+          if (coverNeighbors) status[iv] = LEAVING;
+        }
+      }
+    }
+  }
+}
+
+void FastMISBatchRunner::settleDecisions() {
+  for (int u = 0; u < numNodes; u++) {
+    for (int r = 0; r < replications; r++) {
+      size_t i = index(u, r);
+      if (status[i] == JOINING) {
+        status[i] = IN_MIS;
+        misSize[r]++;
+        activeNodes[r]--;
+      } else if (status[i] == LEAVING) {
+        status[i] = COVERED;
+        activeNodes[r]--;
+      }
+    }
+  }
+}
+
+void FastMISBatchRunner::completePhase() {
+  for (int r = 0; r < replications; r++) {
+    if (phases[r] == 0 && activeNodes[r] == 0) {
+      phases[r] = currentPhase;
+      activeReplications--;
+    }
+  }
+
+  EV << "Batch phase " << currentPhase << " done, " << activeReplications
+     << " replications still running" << endl;
+}
+
+/**
+ * Checks the final decisions of every replication as MISVerifier does for a
+ * single run: counts links between two MIS nodes, from their lower end only,
+ * and nodes that are neither in MIS nor next to one. Replications are the
+ * inner loop, so each replication costs O(V+E) on the shared adjacency.
+ */
+void FastMISBatchRunner::verify(long& violations, long& uncovered) const {
+  violations = 0;
+  uncovered = 0;
+  std::vector<char> covered(replications);
+  for (int u = 0; u < numNodes; u++) {
+    for (int r = 0; r < replications; r++) {
+      covered[r] = status[index(u, r)] == IN_MIS;
+    }
+    for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+      int v = graph.adjacency[e];
+      for (int r = 0; r < replications; r++) {
+        if (status[index(v, r)] != IN_MIS) continue;
+        if (u < v && status[index(u, r)] == IN_MIS) violations++;
+        covered[r] = true;
+      }
+    }
+    uncovered += std::count(covered.begin(), covered.end(), 0);
+  }
+}
+
+void FastMISBatchRunner::finish() {
+  cancelAndDelete(phaseStartMsg);
+
+  double wallClockTime = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - wallClockStart)
+                             .count();
+
+  for (int r = 0; r < replications; r++) {
+    if (phases[r] == 0) continue;  // Did not converge
+    misSizeStats.collect(misSize[r]);
+    phaseStats.collect(phases[r]);
+    // Phases times phaseInterval, not FastMISNode's per-node decision time
+    phaseConvergenceTimeStats.collect(phases[r] * phaseInterval);
+    messageOverheadStats.collect(messagesSent[r] + messagesReceived[r]);
+  }
+
+  long violations, uncovered;
+  verify(violations, uncovered);
+
+  double throughput = wallClockTime > 0 ? replications / wallClockTime : 0;
+
+  // Print to both EV and cout to ensure visibility
+  std::string msg =
+      "Batch of " + std::to_string(replications) + " replications on " +
+      std::to_string(numNodes) + " nodes finished in " +
+      std::to_string(wallClockTime) + " s (" + std::to_string(throughput) +
+      " replications/s), mean MIS size " +
+      std::to_string(misSizeStats.getMean()) + ", " +
+      std::to_string(violations) + " independence violations, " +
+      std::to_string(uncovered) + " uncovered nodes";
+
+  EV << msg << endl;
+  std::cout << "INFO: " << msg << std::endl;
+
+  // Record comprehensive statistics
+  recordScalar("replications", replications);
+  recordScalar("convergedReplications", misSizeStats.getCount());
+  recordScalar("wallClockTime", wallClockTime);
+  recordScalar("replicationsPerSecond", throughput);
+  misSizeStats.record();
+  phaseStats.record();
+  phaseConvergenceTimeStats.record();
+  messageOverheadStats.record();
+  recordScalar("independenceViolations", violations);
+  recordScalar("uncoveredNodes", uncovered);
+
+  if (failOnViolation && (violations > 0 || uncovered > 0)) {
+    throw cRuntimeError("Invalid MIS: %ld independence violations, "
+                        "%ld uncovered nodes over %d replications",
+                        violations, uncovered, replications);
+  }
+}
@@ -0,0 +1,84 @@
+#ifndef __FASTMISBATCHRUNNER_H
+#define __FASTMISBATCHRUNNER_H
+
+#include <omnetpp.h>
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "MISGraph.h"
+
+using namespace omnetpp;
+
+// Passive node that only carries the topology for FastMISBatchRunner
+class MISTopologyNode : public cSimpleModule {};
+
+/**
+ * Runs many FastMIS replications over one topology within a single run.
+ * The topology is read once from the MISTopologyNode siblings into a
+ * MISGraph, and each replication advances FastMIS phases
+ * synchronously, one event per phase for all replications. Joins cascade
+ * within a phase as terminate notifications shrink neighborhoods.
+ */
+class FastMISBatchRunner : public cSimpleModule {
+ public:
+  enum NodeStatus : uint8_t { ACTIVE, IN_MIS, COVERED, JOINING, LEAVING };
+
+ private:
+  int numNodes;
+  int replications;
+  int currentPhase;
+  int activeReplications;
+  bool failOnViolation;
+
+  MISGraph graph;
+
+  // Per node and replication state, indexed by node * replications + rep
+  std::vector<uint8_t> status;
+  std::vector<double> randomValue;
+  std::vector<double> minNeighborValue;
+
+  // Per replication state
+  std::vector<std::mt19937_64> rngs;
+  std::vector<int> activeNodes;
+  std::vector<int> misSize;
+  std::vector<int> phases;
+  std::vector<long> messagesSent;
+  std::vector<long> messagesReceived;
+
+  // Self-scheduling messages
+  cMessage* phaseStartMsg;
+
+  // Timing parameters
+  double phaseInterval;
+
+  // Statistics tracking
+  std::chrono::steady_clock::time_point wallClockStart;
+  cStdDev misSizeStats;
+  cStdDev phaseStats;
+  cStdDev phaseConvergenceTimeStats;
+  cStdDev messageOverheadStats;
+
+ protected:
+  virtual void initialize() override;
+  virtual void handleMessage(cMessage* msg) override;
+  virtual void finish() override;
+
+ private:
+  void buildTopology();
+  void runPhase();
+  void exchangeRandomValues();
+  bool markJoiningNodes();
+  bool markCascadeJoins();
+  void notifyNeighbors(uint8_t sender, bool coverNeighbors);
+  void settleDecisions();
+  void completePhase();
+  void verify(long& violations, long& uncovered) const;
+  size_t index(int node, int rep) const {
+    return (size_t)node * replications + rep;
+  }
+};
+
+#endif
@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+#include "MISCheckpointer.h"
+
 Define_Module(FastMISNode);
 
 void FastMISNode::initialize() {
@@ -16,6 +18,8 @@ void FastMISNode::initialize() {
   totalMessagesReceived = 0;
   controlMessagesReceived = 0;
   dataMessagesReceived = 0;
+  clusterMessagesSent = 0;
+  clusterMessagesReceived = 0;
   algorithmStartTime = simTime();
   algorithmEndTime = 0;
 
@@ -24,12 +28,25 @@ void FastMISNode::initialize() {
   clusterSizeSignal = registerSignal("clusterSize");
   msgOverheadSignal = registerSignal("msgOverhead");
   convergenceTimeSignal = registerSignal("convergenceTime");
+  trace = MISTraceRecorder::find(this);
+  progress = MISProgressCollector::find(this);
 
   // Initialize timing parameters
   phaseInterval = par("phaseInterval").doubleValue();
   initialStartDelay = par("initialStartDelay").doubleValue();
   randomValueSendDelay = par("randomValueSendDelay").doubleValue();
 
+  // Initialize cluster formation parameters
+  clusteringEnabled = par("clusteringEnabled").boolValue();
+  clusterAffiliationDelay = par("clusterAffiliationDelay").doubleValue();
+  clusterReportDelay = par("clusterReportDelay").doubleValue();
+  if (clusteringEnabled && clusterReportDelay <= clusterAffiliationDelay) {
+    throw cRuntimeError(
+        "clusterReportDelay must be larger than clusterAffiliationDelay");
+  }
+  clusterHeadId = -1;
+  clusterMemberCount = 0;
+
   // Initialize neighbor set based on connected gates
   for (int i = 0; i < gateSize("out"); i++) {
     if (gate("out", i)->isConnected()) {
@@ -46,22 +63,30 @@ void FastMISNode::initialize() {
   // Initialize self-messages
   phaseStartMsg = new cMessage("phaseStart");
   sendRandomValueMsg = new cMessage("sendRandomValue");
+  clusterAffiliationMsg = new cMessage("clusterAffiliation");
+  clusterReportMsg = new cMessage("clusterReport");
 
   // Set default visual appearance for active nodes
   getDisplayString().setTagArg("i", 0, "device/laptop");
   getDisplayString().setTagArg("i", 1, "blue");
   getDisplayString().setTagArg("i", 2, "35");
 
-  // Start the algorithm with uniform delay
-  scheduleAt(simTime() + uniform(0, initialStartDelay), phaseStartMsg);
+  // Start the algorithm with uniform delay, unless the checkpointer restores
+  // the pending events of an earlier run
+  if (!MISCheckpointer::isResuming(this)) {
+    scheduleAt(simTime() + uniform(0, initialStartDelay), phaseStartMsg);
+  }
 
   EV << "FastMISNode " << nodeId << " initialized with "
      << activeNeighbors.size() << " neighbors" << endl;
 }
 
 void FastMISNode::handleMessage(cMessage* msg) {
+  if (progress && !msg->isSelfMessage()) progress->messageReceived();
+
   if (terminated && !msg->isSelfMessage()) {
-    delete msg;
+    // Only cluster formation traffic matters after termination
+    handleClusterMessage(msg);
     return;
   }
 
@@ -75,6 +100,10 @@ void FastMISNode::handleMessage(cMessage* msg) {
     }
   } else if (msg == sendRandomValueMsg) {
     sendRandomValue();
+  } else if (msg == clusterAffiliationMsg) {
+    chooseClusterHead();
+  } else if (msg == clusterReportMsg) {
+    reportClusterSize();
   } else {
     // Process messages from others
     // We need to delete these at the end
@@ -100,6 +129,8 @@ void FastMISNode::startNewPhase() {
   currentPhase++;
   resetPhaseData();
 
+  if (trace) trace->record(TRACE_PHASE_START, nodeId, currentPhase);
+
   EV << "Node " << nodeId << " starting phase " << currentPhase << endl;
 
   // Schedule sending random value after configured delay
@@ -113,6 +144,11 @@ void FastMISNode::sendRandomValue() {
   // Generate random value
   myRandomValue = uniform(0, 1);
 
+  if (trace) {
+    trace->record(TRACE_VALUE_SENT, nodeId, currentPhase, -1, -1,
+                  myRandomValue);
+  }
+
   EV << "Node " << nodeId << " generated random value: " << myRandomValue
      << endl;
 
@@ -122,7 +158,7 @@ void FastMISNode::sendRandomValue() {
   msg->setRandomValue(myRandomValue);
   msg->setPhase(currentPhase);
 
-  broadcastToNeighbors(msg);
+  totalMessagesSent += broadcastToNeighbors(msg);
 }
 
 void FastMISNode::tryMakeDecision() {
@@ -167,12 +203,17 @@ bool FastMISNode::shouldJoinMIS() {
 
 void FastMISNode::JoinMIS() {
   inMIS = true;
+  clusterHeadId = nodeId;
   algorithmEndTime = simTime();
 
   // Emit statistics
   emit(phaseSignal, currentPhase);
   emit(convergenceTimeSignal, (algorithmEndTime - algorithmStartTime).dbl());
 
+  if (trace) {
+    trace->record(TRACE_JOIN, nodeId, currentPhase, -1, -1, myRandomValue);
+  }
+
   // Change visual appearance to indicate MIS membership
   getDisplayString().setTagArg("i", 0, "device/server");
   getDisplayString().setTagArg("i", 1, "green");
@@ -185,8 +226,11 @@ void FastMISNode::JoinMIS() {
   MISJoinNotification* msg = new MISJoinNotification("JoinMIS");
   msg->setSenderId(nodeId);
   msg->setPhase(currentPhase);
+  // Advertise only neighbors that are still undecided and may affiliate,
+  // not those already covered by heads of earlier phases
+  msg->setLoad(activeNeighbors.size());
 
-  broadcastToNeighbors(msg);
+  totalMessagesSent += broadcastToNeighbors(msg);
 
   // Terminate after joining MIS
   terminate();
@@ -194,6 +238,7 @@ void FastMISNode::JoinMIS() {
 
 void FastMISNode::terminate() {
   terminated = true;
+  if (progress) progress->nodeDecided(this);
 
   if (!algorithmEndTime.isZero() == false) {
     algorithmEndTime = simTime();
@@ -217,10 +262,20 @@ void FastMISNode::terminate() {
   msg->setSenderId(nodeId);
   msg->setPhase(currentPhase);
 
-  broadcastToNeighbors(msg);
+  totalMessagesSent += broadcastToNeighbors(msg);
 
   // Cancel all pending messages
   if (phaseStartMsg->isScheduled()) cancelEvent(phaseStartMsg);
+
+  // Start cluster formation. Heads wait for affiliations, members wait for
+  // heads that joined concurrently before picking one.
+  if (clusteringEnabled) {
+    if (inMIS) {
+      scheduleAt(simTime() + clusterReportDelay, clusterReportMsg);
+    } else {
+      scheduleAt(simTime() + clusterAffiliationDelay, clusterAffiliationMsg);
+    }
+  }
 }
 
 void FastMISNode::processRandomValue(MISRandomValue* msg) {
@@ -228,6 +283,10 @@ void FastMISNode::processRandomValue(MISRandomValue* msg) {
   controlMessagesReceived++;
 
   if (msg->getPhase() != currentPhase) {
+    if (trace) {
+      trace->record(TRACE_STALE_DROP, nodeId, currentPhase, msg->getSenderId(),
+                    msg->getPhase(), msg->getRandomValue());
+    }
     EV_WARN << "Node " << nodeId << " received random value "
             << msg->getRandomValue() << " from neighbor " << msg->getSenderId()
             << " but our phase: " << currentPhase
@@ -242,6 +301,11 @@ void FastMISNode::processRandomValue(MISRandomValue* msg) {
   if (activeNeighbors.find(senderId) != activeNeighbors.end()) {
     neighborRandomValues[senderId] = value;
 
+    if (trace) {
+      trace->record(TRACE_VALUE_RECEIVED, nodeId, currentPhase, senderId,
+                    msg->getPhase(), value);
+    }
+
     EV << "Node " << nodeId << " received random value " << value
        << " from neighbor " << senderId << endl;
   }
@@ -254,6 +318,10 @@ void FastMISNode::processJoinNotification(MISJoinNotification* msg) {
   controlMessagesReceived++;
 
   if (msg->getPhase() != currentPhase) {
+    if (trace) {
+      trace->record(TRACE_STALE_DROP, nodeId, currentPhase, msg->getSenderId(),
+                    msg->getPhase(), -1);
+    }
     EV_WARN << "Node " << nodeId
             << " received join notification value from neighbor "
             << msg->getSenderId() << " but our phase: " << currentPhase
@@ -265,10 +333,16 @@ void FastMISNode::processJoinNotification(MISJoinNotification* msg) {
 
   if (activeNeighbors.find(senderId) != activeNeighbors.end()) {
     neighborsInMIS.insert(senderId);
+    headLoads[senderId] = msg->getLoad();
 
     EV << "Node " << nodeId << " is notified that neighbor " << senderId
        << " joined MIS" << endl;
 
+    if (trace) {
+      trace->record(TRACE_TERMINATE, nodeId, currentPhase, senderId,
+                    msg->getPhase());
+    }
+
     // Terminate because a neighbor joined MIS
     terminate();
   }
@@ -291,7 +365,116 @@ void FastMISNode::processTerminateNotification(MISTerminateNotification* msg) {
   tryMakeDecision();
 }
 
-void FastMISNode::broadcastToNeighbors(cMessage* msg) {
+void FastMISNode::handleClusterMessage(cMessage* msg) {
+  if (MISJoinNotification* joinMsg = dynamic_cast<MISJoinNotification*>(msg)) {
+    recordClusterHead(joinMsg);
+  } else if (MISClusterAffiliation* affMsg =
+                 dynamic_cast<MISClusterAffiliation*>(msg)) {
+    processClusterAffiliation(affMsg);
+  } else if (MISClusterReport* reportMsg =
+                 dynamic_cast<MISClusterReport*>(msg)) {
+    processClusterReport(reportMsg);
+  }
+  delete msg;
+}
+
+/**
+ * A neighbor may join MIS in the same phase as the head that made us
+ * terminate. Remember it as a candidate head as long as we have not picked
+ * one yet.
+ */
+void FastMISNode::recordClusterHead(MISJoinNotification* msg) {
+  if (inMIS || clusterHeadId != -1) return;
+
+  int senderId = msg->getSenderId();
+  neighborsInMIS.insert(senderId);
+  headLoads[senderId] = msg->getLoad();
+
+  EV << "Node " << nodeId << " recorded neighbor " << senderId
+     << " as candidate cluster head with load " << msg->getLoad() << endl;
+}
+
+/**
+ * Picks the least-loaded head among the neighbors in MIS, ties broken by
+ * lower ID, and notifies only that head.
+ */
+void FastMISNode::chooseClusterHead() {
+  if (neighborsInMIS.empty()) {
+    EV_WARN << "Node " << nodeId << " has no neighbor in MIS to affiliate with"
+            << endl;
+    return;
+  }
+
+  int bestHead = -1;
+  int bestLoad = 0;
+  for (int headId : neighborsInMIS) {
+    int load = headLoads[headId];
+    if (bestHead == -1 || load < bestLoad) {
+      bestHead = headId;
+      bestLoad = load;
+    }
+  }
+  clusterHeadId = bestHead;
+
+  EV << "Node " << nodeId << " joins cluster of head " << clusterHeadId
+     << " (load " << bestLoad << ", " << neighborsInMIS.size()
+     << " candidates)" << endl;
+
+  MISClusterAffiliation* msg = new MISClusterAffiliation("ClusterAffiliation");
+  msg->setSenderId(nodeId);
+  msg->setHeadId(clusterHeadId);
+
+  sendToNeighbor(msg, clusterHeadId);
+  clusterMessagesSent++;
+}
+
+void FastMISNode::processClusterAffiliation(MISClusterAffiliation* msg) {
+  clusterMessagesReceived++;
+
+  if (!inMIS || msg->getHeadId() != nodeId) return;
+
+  if (!clusterReportMsg->isScheduled()) {
+    EV_WARN << "Head " << nodeId << " received late affiliation from node "
+            << msg->getSenderId() << endl;
+    return;
+  }
+
+  clusterMemberCount++;
+
+  EV << "Head " << nodeId << " accepted member " << msg->getSenderId()
+     << ". Members: " << clusterMemberCount << endl;
+}
+
+/**
+ * Announces the final member count with one message per head, so members do
+ * not need individual acknowledgements.
+ */
+void FastMISNode::reportClusterSize() {
+  // Cluster size includes the head itself
+  emit(clusterSizeSignal, clusterMemberCount + 1);
+
+  EV << "Head " << nodeId << " formed a cluster of size "
+     << clusterMemberCount + 1 << endl;
+
+  MISClusterReport* msg = new MISClusterReport("ClusterReport");
+  msg->setSenderId(nodeId);
+  msg->setMemberCount(clusterMemberCount);
+
+  clusterMessagesSent += broadcastToNeighbors(msg);
+}
+
+void FastMISNode::processClusterReport(MISClusterReport* msg) {
+  clusterMessagesReceived++;
+
+  if (msg->getSenderId() != clusterHeadId) return;
+
+  clusterMemberCount = msg->getMemberCount();
+
+  EV << "Node " << nodeId << " confirmed in cluster of head " << clusterHeadId
+     << " with " << clusterMemberCount << " members" << endl;
+}
+
+int FastMISNode::broadcastToNeighbors(cMessage* msg) {
   int sentCount = 0;
   for (int i = 0; i < gateSize("out"); i++) {
     if (gate("out", i)->isConnected()) {
@@ -299,7 +482,25 @@ void FastMISNode::broadcastToNeighbors(cMessage* msg) {
       sentCount++;
     }
   }
-  totalMessagesSent += sentCount;
+  delete msg;
+  if (progress) progress->messagesSent(sentCount);
+  return sentCount;
+}
+
+void FastMISNode::sendToNeighbor(cMessage* msg, int neighborId) {
+  for (int i = 0; i < gateSize("out"); i++) {
+    if (gate("out", i)->isConnected()) {
+      cGate* connectedGate = gate("out", i)->getNextGate();
+      if (connectedGate && connectedGate->getOwnerModule() &&
+          (int)connectedGate->getOwnerModule()->par("nodeId") == neighborId) {
+        send(msg, "out", i);
+        if (progress) progress->messagesSent(1);
+        return;
+      }
+    }
+  }
+  EV_WARN << "Node " << nodeId << " has no gate to neighbor " << neighborId
+          << endl;
   delete msg;
 }
 
@@ -336,9 +537,84 @@ void FastMISNode::logPhaseEnd() {
      << " with all random values (sorted) " << oss.str() << endl;
 }
 
+void FastMISNode::saveState(CheckpointWriter& out) {
+  out.write(currentPhase);
+  out.write(inMIS);
+  out.write(terminated);
+  out.write(myRandomValue);
+  out.write(activeNeighbors);
+  out.write(neighborRandomValues);
+  out.write(neighborsInMIS);
+  out.write(clusterHeadId);
+  out.write(clusterMemberCount);
+  out.write(headLoads);
+  out.write(totalMessagesSent);
+  out.write(totalMessagesReceived);
+  out.write(controlMessagesReceived);
+  out.write(dataMessagesReceived);
+  out.write(clusterMessagesSent);
+  out.write(clusterMessagesReceived);
+  out.write(algorithmEndTime);
+}
+
+void FastMISNode::loadState(CheckpointReader& in) {
+  in.read(currentPhase);
+  in.read(inMIS);
+  in.read(terminated);
+  in.read(myRandomValue);
+  in.read(activeNeighbors);
+  in.read(neighborRandomValues);
+  in.read(neighborsInMIS);
+  in.read(clusterHeadId);
+  in.read(clusterMemberCount);
+  in.read(headLoads);
+  in.read(totalMessagesSent);
+  in.read(totalMessagesReceived);
+  in.read(controlMessagesReceived);
+  in.read(dataMessagesReceived);
+  in.read(clusterMessagesSent);
+  in.read(clusterMessagesReceived);
+  in.read(algorithmEndTime);
+
+  if (inMIS) {
+    getDisplayString().setTagArg("i", 0, "device/server");
+    getDisplayString().setTagArg("i", 1, "green");
+    getDisplayString().setTagArg("i", 2, "50");
+  } else if (terminated) {
+    getDisplayString().setTagArg("i", 0, "device/pc");
+    getDisplayString().setTagArg("i", 1, "red");
+    getDisplayString().setTagArg("i", 2, "30");
+  }
+}
+
+int FastMISNode::selfMessageSlot(cMessage* msg) const {
+  if (msg == phaseStartMsg) return 0;
+  if (msg == sendRandomValueMsg) return 1;
+  if (msg == clusterAffiliationMsg) return 2;
+  if (msg == clusterReportMsg) return 3;
+  return -1;
+}
+
+void FastMISNode::restoreSelfMessage(int slot, simtime_t arrivalTime) {
+  Enter_Method_Silent();
+  cMessage* selfMessages[] = {phaseStartMsg, sendRandomValueMsg,
+                              clusterAffiliationMsg, clusterReportMsg};
+  if (slot < 0 || slot > 3) {
+    throw cRuntimeError("Invalid self-message slot %d in checkpoint", slot);
+  }
+  scheduleAt(arrivalTime, selfMessages[slot]);
+}
+
+void FastMISNode::restoreInFlight(cMessage* msg, int gateIndex,
+                                  simtime_t arrivalTime) {
+  redeliverInFlight(msg, gate("out", gateIndex), arrivalTime);
+}
+
 void FastMISNode::finish() {
   cancelAndDelete(phaseStartMsg);
   cancelAndDelete(sendRandomValueMsg);
+  cancelAndDelete(clusterAffiliationMsg);
+  cancelAndDelete(clusterReportMsg);
 
   // Print to both EV and cout to ensure visibility
   std::string msg = "Node " + std::to_string(nodeId) + " finished at " +
@@ -367,4 +643,16 @@ void FastMISNode::finish() {
       currentPhase > 0
           ? (double)(totalMessagesSent + totalMessagesReceived) / currentPhase
           : 0);
+
+  // Cluster formation statistics, kept apart from the MIS message overhead
+  if (clusteringEnabled) {
+    recordScalar("clusterHead", clusterHeadId);
+    recordScalar("clusterMessageOverhead",
+                 clusterMessagesSent + clusterMessagesReceived);
+    if (inMIS) {
+      recordScalar("clusterSize", clusterMemberCount + 1);
+    } else if (clusterHeadId != -1) {
+      recordScalar("headMemberCount", clusterMemberCount);
+    }
+  }
 }
\ No newline at end of file
@@ -6,11 +6,17 @@
 #include <map>
 #include <set>
 
+#include "Checkpoint.h"
+#include "MISGraph.h"
+#include "MISProgressCollector.h"
+#include "MISTraceRecorder.h"
 #include "message_m.h"
 
 using namespace omnetpp;
 
-class FastMISNode : public cSimpleModule {
+class FastMISNode : public cSimpleModule,
+                    public ICheckpointable,
+                    public IMISMember {
  private:
   int nodeId;
   int currentPhase;
@@ -23,20 +29,32 @@ class FastMISNode : public cSimpleModule {
   std::map<int, double> neighborRandomValues;
   std::set<int> neighborsInMIS;
 
+  // Cluster formation state
+  bool clusteringEnabled;
+  int clusterHeadId;
+  int clusterMemberCount;
+  std::map<int, int> headLoads;  // Expected load advertised by each head
+
   // Self-scheduling messages
   cMessage* phaseStartMsg;
   cMessage* sendRandomValueMsg;
+  cMessage* clusterAffiliationMsg;
+  cMessage* clusterReportMsg;
 
   // Timing parameters
   double phaseInterval;
   double initialStartDelay;
   double randomValueSendDelay;
+  double clusterAffiliationDelay;
+  double clusterReportDelay;
 
   // Statistics tracking
   int totalMessagesSent;
   int totalMessagesReceived;
   int controlMessagesReceived;
   int dataMessagesReceived;
+  int clusterMessagesSent;
+  int clusterMessagesReceived;
   simtime_t algorithmStartTime;
   simtime_t algorithmEndTime;
   int initialNeighborCount;
@@ -45,11 +63,29 @@ class FastMISNode : public cSimpleModule {
   simsignal_t msgOverheadSignal;
   simsignal_t convergenceTimeSignal;
 
+  // Binary event trace, nullptr unless tracing is enabled
+  MISTraceRecorder* trace;
+
+  // Network-level progress counters, nullptr unless sampling is enabled
+  MISProgressCollector* progress;
+
  protected:
   virtual void initialize() override;
   virtual void handleMessage(cMessage* msg) override;
   virtual void finish() override;
 
+ public:
+  // Checkpoint support, see MISCheckpointer
+  virtual void saveState(CheckpointWriter& out) override;
+  virtual void loadState(CheckpointReader& in) override;
+  virtual int selfMessageSlot(cMessage* msg) const override;
+  virtual void restoreSelfMessage(int slot, simtime_t arrivalTime) override;
+  virtual void restoreInFlight(cMessage* msg, int gateIndex,
+                               simtime_t arrivalTime) override;
+
+  // Final MIS membership, see MISVerifier
+  virtual bool isInMIS() const override { return inMIS; }
+
  private:
   void startNewPhase();
   void sendRandomValue();
@@ -60,7 +96,14 @@ class FastMISNode : public cSimpleModule {
   void processJoinNotification(MISJoinNotification* msg);
   void processTerminateNotification(MISTerminateNotification* msg);
   bool shouldJoinMIS();
-  void broadcastToNeighbors(cMessage* msg);
+  void handleClusterMessage(cMessage* msg);
+  void recordClusterHead(MISJoinNotification* msg);
+  void chooseClusterHead();
+  void processClusterAffiliation(MISClusterAffiliation* msg);
+  void reportClusterSize();
+  void processClusterReport(MISClusterReport* msg);
+  int broadcastToNeighbors(cMessage* msg);
+  void sendToNeighbor(cMessage* msg, int neighborId);
   void resetPhaseData();
   void logPhaseEnd();
 };
@@ -0,0 +1,415 @@
+#include "MISCheckpointer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "MISGraph.h"
+
+Define_Module(MISCheckpointer);
+
+static const char* CHECKPOINT_MAGIC = "MISCKPT";
+static const uint32_t CHECKPOINT_VERSION = 2;
+
+enum EventType : uint8_t { SELF_MESSAGE, IN_FLIGHT };
+
+enum MessageType : uint8_t {
+  RANDOM_VALUE,
+  JOIN_NOTIFICATION,
+  TERMINATE_NOTIFICATION,
+  CLUSTER_AFFILIATION,
+  CLUSTER_REPORT,
+  COLOR_ANNOUNCEMENT
+};
+
+bool MISCheckpointer::isResuming(cModule* node) {
+  cModule* checkpointer = node->getParentModule()->getSubmodule("checkpointer");
+  return checkpointer &&
+         !checkpointer->par("resumeFrom").stdstringValue().empty();
+}
+
+void MISCheckpointer::initialize(int stage) {
+  if (stage == 0) {
+    checkpointInterval = par("checkpointInterval").doubleValue();
+    checkpointFile = par("checkpointFile").stdstringValue();
+    resumeFrom = par("resumeFrom").stdstringValue();
+    checkpointMsg = new cMessage("checkpoint");
+    checkpointsWritten = 0;
+  } else if (stage == 2) {
+    // Nodes have finished their own initialization by now, ColoringMISNode
+    // builds its schedule in stage 1. A resumed run keeps the snapshot
+    // times of the run it continues.
+    simtime_t resumedAt = resumeFrom.empty() ? simTime() : readCheckpoint();
+    scheduleNextCheckpoint(resumedAt);
+  }
+}
+
+void MISCheckpointer::handleMessage(cMessage* msg) {
+  if (msg == checkpointMsg) {
+    writeCheckpoint();
+
+    // Do not keep an otherwise finished simulation alive
+    if (!getSimulation()->getFES()->isEmpty()) {
+      scheduleNextCheckpoint(simTime());
+    }
+  } else {
+    EV_WARN << "Unknown message has been received!" << endl;
+    delete msg;
+  }
+}
+
+void MISCheckpointer::scheduleNextCheckpoint(simtime_t after) {
+  if (checkpointInterval <= 0) return;
+
+  double periods = std::floor(after.dbl() / checkpointInterval);
+  scheduleAt((periods + 1) * checkpointInterval, checkpointMsg);
+}
+
+/**
+ * Node count, link count and a hash of the connection graph of the MIS
+ * nodes. Positions follow submodule order, so the same network always
+ * yields the same fingerprint.
+ */
+MISCheckpointer::TopologyFingerprint MISCheckpointer::fingerprintTopology() {
+  MISGraph graph;
+  graph.build(getParentModule());
+
+  // FNV-1a over the neighbor positions of every node in turn
+  TopologyFingerprint fingerprint = {(uint32_t)graph.size(),
+                                     (uint32_t)graph.links(),
+                                     14695981039346656037ULL};
+  auto mix = [&fingerprint](uint32_t value) {
+    fingerprint.hash = (fingerprint.hash ^ value) * 1099511628211ULL;
+  };
+  for (int u = 0; u < graph.size(); u++) {
+    for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+      mix(graph.adjacency[e]);
+    }
+    mix(UINT32_MAX);  // Node separator
+  }
+  return fingerprint;
+}
+
+/**
+ * Snapshot layout: header, state of every checkpointable sibling, then the
+ * pending events sorted into execution order. In-flight messages are stored
+ * with their sender and output gate so the sender can re-deliver them.
+ */
+void MISCheckpointer::writeCheckpoint() {
+  std::string tmpFile = checkpointFile + ".tmp";
+  {
+    CheckpointWriter out(tmpFile);
+    out.write(std::string(CHECKPOINT_MAGIC));
+    out.write(CHECKPOINT_VERSION);
+    out.write(simTime());
+    out.write((uint64_t)getRNG(0)->getNumbersDrawn());
+
+    // What the snapshot belongs to, checked before resuming
+    cConfigurationEx* config = getEnvir()->getConfigEx();
+    TopologyFingerprint topology = fingerprintTopology();
+    out.write(std::string(config->getActiveConfigName()));
+    out.write(config->getActiveRunNumber());
+    out.write(topology.nodes);
+    out.write(topology.links);
+    out.write(topology.hash);
+
+    // Module state
+    std::vector<cModule*> modules;
+    for (cModule::SubmoduleIterator it(getParentModule()); !it.end(); ++it) {
+      if (dynamic_cast<ICheckpointable*>(*it)) modules.push_back(*it);
+    }
+    out.write((uint32_t)modules.size());
+    for (cModule* mod : modules) {
+      out.write(mod->getFullPath());
+      dynamic_cast<ICheckpointable*>(mod)->saveState(out);
+    }
+
+    // Pending events, in the order the scheduler would execute them
+    std::vector<cMessage*> events;
+    cFutureEventSet* fes = getSimulation()->getFES();
+    for (int i = 0; i < fes->getLength(); i++) {
+      cMessage* msg = dynamic_cast<cMessage*>(fes->get(i));
+      if (!msg) {
+        throw cRuntimeError("Cannot checkpoint non-message event %s",
+                            fes->get(i)->getName());
+      }
+      if (msg != checkpointMsg) events.push_back(msg);
+    }
+    std::sort(events.begin(), events.end(), [](cMessage* a, cMessage* b) {
+      if (a->getArrivalTime() != b->getArrivalTime())
+        return a->getArrivalTime() < b->getArrivalTime();
+      if (a->getSchedulingPriority() != b->getSchedulingPriority())
+        return a->getSchedulingPriority() < b->getSchedulingPriority();
+      return a->getInsertOrder() < b->getInsertOrder();
+    });
+
+    out.write((uint32_t)events.size());
+    for (cMessage* msg : events) {
+      if (msg->isSelfMessage()) {
+        cModule* owner = msg->getArrivalModule();
+        ICheckpointable* node = dynamic_cast<ICheckpointable*>(owner);
+        int slot = node ? node->selfMessageSlot(msg) : -1;
+        if (slot < 0) {
+          throw cRuntimeError("Cannot checkpoint self-message %s of %s",
+                              msg->getName(), owner->getFullPath().c_str());
+        }
+        out.write(SELF_MESSAGE);
+        out.write(owner->getFullPath());
+        out.write(slot);
+        out.write(msg->getArrivalTime());
+      } else {
+        cModule* sender = msg->getSenderModule();
+        if (!msg->getSenderGate() || !dynamic_cast<ICheckpointable*>(sender)) {
+          throw cRuntimeError("Cannot checkpoint in-flight message %s",
+                              msg->getName());
+        }
+        out.write(IN_FLIGHT);
+        out.write(sender->getFullPath());
+        out.write(msg->getSenderGate()->getIndex());
+        out.write(msg->getArrivalTime());
+        out.write(msg->getSchedulingPriority());
+        writeMessage(out, msg);
+      }
+    }
+
+    if (!out.good()) {
+      throw cRuntimeError("Writing checkpoint %s failed", tmpFile.c_str());
+    }
+  }
+
+  // Replace the previous checkpoint only once the new one is complete
+  if (std::rename(tmpFile.c_str(), checkpointFile.c_str()) != 0) {
+    throw cRuntimeError("Cannot move checkpoint to %s", checkpointFile.c_str());
+  }
+  checkpointsWritten++;
+
+  EV << "Checkpoint written to " << checkpointFile << " at " << simTime()
+     << endl;
+}
+
+simtime_t MISCheckpointer::readCheckpoint() {
+  CheckpointReader in(resumeFrom);
+
+  std::string magic;
+  uint32_t version;
+  in.read(magic);
+  in.read(version);
+  if (magic != CHECKPOINT_MAGIC || version != CHECKPOINT_VERSION) {
+    throw cRuntimeError("%s is not a version %u MIS checkpoint",
+                        resumeFrom.c_str(), CHECKPOINT_VERSION);
+  }
+
+  simtime_t checkpointTime;
+  uint64_t numbersDrawn;
+  in.read(checkpointTime);
+  in.read(numbersDrawn);
+
+  // Refuse snapshots of another config, run or network
+  std::string configName;
+  int runNumber;
+  TopologyFingerprint topology;
+  in.read(configName);
+  in.read(runNumber);
+  in.read(topology.nodes);
+  in.read(topology.links);
+  in.read(topology.hash);
+
+  cConfigurationEx* config = getEnvir()->getConfigEx();
+  if (configName != config->getActiveConfigName() ||
+      runNumber != config->getActiveRunNumber()) {
+    throw cRuntimeError("Checkpoint %s was taken in config %s run %d, "
+                        "cannot resume it in config %s run %d",
+                        resumeFrom.c_str(), configName.c_str(), runNumber,
+                        config->getActiveConfigName(),
+                        config->getActiveRunNumber());
+  }
+  TopologyFingerprint current = fingerprintTopology();
+  if (topology.nodes != current.nodes || topology.links != current.links ||
+      topology.hash != current.hash) {
+    throw cRuntimeError("Checkpoint %s was taken on a different topology "
+                        "(%u nodes, %u links), this network has %u nodes "
+                        "and %u links",
+                        resumeFrom.c_str(), topology.nodes, topology.links,
+                        current.nodes, current.links);
+  }
+
+  uint32_t moduleCount;
+  in.read(moduleCount);
+  for (uint32_t i = 0; i < moduleCount; i++) {
+    std::string path;
+    in.read(path);
+    findCheckpointable(path)->loadState(in);
+  }
+
+  // Re-inserting in execution order keeps ties at equal times intact
+  uint32_t eventCount;
+  in.read(eventCount);
+  for (uint32_t i = 0; i < eventCount; i++) {
+    uint8_t type;
+    std::string path;
+    int index;
+    simtime_t arrivalTime;
+    in.read(type);
+    in.read(path);
+    in.read(index);
+    in.read(arrivalTime);
+
+    ICheckpointable* node = findCheckpointable(path);
+    if (type == SELF_MESSAGE) {
+      node->restoreSelfMessage(index, arrivalTime);
+    } else {
+      short priority;
+      in.read(priority);
+      cMessage* msg = readMessage(in);
+      msg->setSchedulingPriority(priority);
+      node->restoreInFlight(msg, index, arrivalTime);
+    }
+  }
+
+  // Fast-forward the shared random number stream to the checkpoint position
+  cRNG* rng = getRNG(0);
+  if (rng->getNumbersDrawn() > numbersDrawn) {
+    throw cRuntimeError("Random stream is past the checkpoint position, "
+                        "resume with the same config and run number");
+  }
+  while (rng->getNumbersDrawn() < numbersDrawn) rng->intRand();
+
+  EV << "Resumed from " << resumeFrom << " taken at " << checkpointTime
+     << " with " << moduleCount << " modules and " << eventCount
+     << " pending events" << endl;
+  return checkpointTime;
+}
+
+ICheckpointable* MISCheckpointer::findCheckpointable(const std::string& path) {
+  ICheckpointable* node = dynamic_cast<ICheckpointable*>(
+      getSimulation()->findModuleByPath(path.c_str()));
+  if (!node) {
+    throw cRuntimeError("Checkpoint module %s does not exist in this network",
+                        path.c_str());
+  }
+  return node;
+}
+
+void MISCheckpointer::writeMessage(CheckpointWriter& out, cMessage* msg) {
+  if (MISRandomValue* m = dynamic_cast<MISRandomValue*>(msg)) {
+    out.write(RANDOM_VALUE);
+    out.write(m->getSenderId());
+    out.write(m->getRandomValue());
+    out.write(m->getPhase());
+  } else if (MISJoinNotification* m = dynamic_cast<MISJoinNotification*>(msg)) {
+    out.write(JOIN_NOTIFICATION);
+    out.write(m->getSenderId());
+    out.write(m->getPhase());
+    out.write(m->getLoad());
+  } else if (MISTerminateNotification* m =
+                 dynamic_cast<MISTerminateNotification*>(msg)) {
+    out.write(TERMINATE_NOTIFICATION);
+    out.write(m->getSenderId());
+    out.write(m->getPhase());
+  } else if (MISClusterAffiliation* m =
+                 dynamic_cast<MISClusterAffiliation*>(msg)) {
+    out.write(CLUSTER_AFFILIATION);
+    out.write(m->getSenderId());
+    out.write(m->getHeadId());
+  } else if (MISClusterReport* m = dynamic_cast<MISClusterReport*>(msg)) {
+    out.write(CLUSTER_REPORT);
+    out.write(m->getSenderId());
+    out.write(m->getMemberCount());
+  } else if (MISColorAnnouncement* m =
+                 dynamic_cast<MISColorAnnouncement*>(msg)) {
+    out.write(COLOR_ANNOUNCEMENT);
+    out.write(m->getSenderId());
+    out.write(m->getColor());
+    out.write(m->getRound());
+  } else {
+    throw cRuntimeError("Cannot checkpoint message %s of type %s",
+                        msg->getName(), msg->getClassName());
+  }
+  out.write(std::string(msg->getName()));
+}
+
+cMessage* MISCheckpointer::readMessage(CheckpointReader& in) {
+  uint8_t type;
+  in.read(type);
+
+  int senderId, a, b;
+  double value;
+  cMessage* msg = nullptr;
+  switch (type) {
+    case RANDOM_VALUE: {
+      MISRandomValue* m = new MISRandomValue();
+      in.read(senderId);
+      in.read(value);
+      in.read(a);
+      m->setSenderId(senderId);
+      m->setRandomValue(value);
+      m->setPhase(a);
+      msg = m;
+      break;
+    }
+    case JOIN_NOTIFICATION: {
+      MISJoinNotification* m = new MISJoinNotification();
+      in.read(senderId);
+      in.read(a);
+      in.read(b);
+      m->setSenderId(senderId);
+      m->setPhase(a);
+      m->setLoad(b);
+      msg = m;
+      break;
+    }
+    case TERMINATE_NOTIFICATION: {
+      MISTerminateNotification* m = new MISTerminateNotification();
+      in.read(senderId);
+      in.read(a);
+      m->setSenderId(senderId);
+      m->setPhase(a);
+      msg = m;
+      break;
+    }
+    case CLUSTER_AFFILIATION: {
+      MISClusterAffiliation* m = new MISClusterAffiliation();
+      in.read(senderId);
+      in.read(a);
+      m->setSenderId(senderId);
+      m->setHeadId(a);
+      msg = m;
+      break;
+    }
+    case CLUSTER_REPORT: {
+      MISClusterReport* m = new MISClusterReport();
+      in.read(senderId);
+      in.read(a);
+      m->setSenderId(senderId);
+      m->setMemberCount(a);
+      msg = m;
+      break;
+    }
+    case COLOR_ANNOUNCEMENT: {
+      MISColorAnnouncement* m = new MISColorAnnouncement();
+      in.read(senderId);
+      in.read(a);
+      in.read(b);
+      m->setSenderId(senderId);
+      m->setColor(a);
+      m->setRound(b);
+      msg = m;
+      break;
+    }
+    default:
+      throw cRuntimeError("Unknown message type %d in checkpoint", type);
+  }
+
+  std::string name;
+  in.read(name);
+  msg->setName(name.c_str());
+  return msg;
+}
+
+void MISCheckpointer::finish() {
+  cancelAndDelete(checkpointMsg);
+
+  recordScalar("checkpointsWritten", checkpointsWritten);
+}
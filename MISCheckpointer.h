@@ -0,0 +1,58 @@
+#ifndef __MISCHECKPOINTER_H
+#define __MISCHECKPOINTER_H
+
+#include <omnetpp.h>
+
+#include <cstdint>
+#include <string>
+
+#include "Checkpoint.h"
+#include "message_m.h"
+
+using namespace omnetpp;
+
+/**
+ * Periodically writes the state of all ICheckpointable siblings together
+ * with every pending event to a binary snapshot, and restores such a
+ * snapshot when resumeFrom is set. A resumed run is event-exact: the
+ * random number stream is fast-forwarded to the same position and pending
+ * events are re-inserted in their original order. Signal-based statistics,
+ * output vectors and the trace recorder are not part of the snapshot and
+ * only cover events after the resume.
+ */
+class MISCheckpointer : public cSimpleModule {
+ private:
+  double checkpointInterval;
+  std::string checkpointFile;
+  std::string resumeFrom;
+  cMessage* checkpointMsg;
+  int checkpointsWritten;
+
+ public:
+  // Nodes skip their initial scheduling when the run resumes a checkpoint
+  static bool isResuming(cModule* node);
+
+ protected:
+  virtual int numInitStages() const override { return 3; }
+  virtual void initialize(int stage) override;
+  virtual void handleMessage(cMessage* msg) override;
+  virtual void finish() override;
+
+ private:
+  // Identifies the network a snapshot belongs to
+  struct TopologyFingerprint {
+    uint32_t nodes;
+    uint32_t links;
+    uint64_t hash;
+  };
+
+  void writeCheckpoint();
+  simtime_t readCheckpoint();
+  void scheduleNextCheckpoint(simtime_t after);
+  TopologyFingerprint fingerprintTopology();
+  ICheckpointable* findCheckpointable(const std::string& path);
+  void writeMessage(CheckpointWriter& out, cMessage* msg);
+  cMessage* readMessage(CheckpointReader& in);
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef __MISGRAPH_H
+#define __MISGRAPH_H
+
+#include <omnetpp.h>
+
+#include <unordered_map>
+#include <vector>
+
+using namespace omnetpp;
+
+// Implemented by nodes whose final MIS membership MISVerifier checks
+class IMISMember {
+ public:
+  virtual ~IMISMember() {}
+  virtual bool isInMIS() const = 0;
+};
+
+/**
+ * Connection graph of the nodes of a network in compressed adjacency form.
+ * Nodes are numbered by their position among the submodules, and the
+ * neighbors of node u are adjacency[offsets[u]] up to adjacency[offsets[u+1]].
+ * Links are bidirectional, so every link appears once from each end.
+ */
+struct MISGraph {
+  std::vector<cModule*> nodes;
+  std::unordered_map<int, int> positions;  // Module ID to position
+  std::vector<int> offsets;
+  std::vector<int> adjacency;
+
+  /**
+   * Reads the submodules of the network that are a Node together with the
+   * links between them over their "out" gates. Positions are assigned by
+   * module ID lookups, so this is O(V+E) whatever the node IDs are.
+   */
+  template <typename Node = IMISMember>
+  void build(cModule* network) {
+    nodes.clear();
+    positions.clear();
+    for (cModule::SubmoduleIterator it(network); !it.end(); ++it) {
+      if (dynamic_cast<Node*>(*it)) {
+        positions[(*it)->getId()] = nodes.size();
+        nodes.push_back(*it);
+      }
+    }
+
+    offsets.assign(nodes.size() + 1, 0);
+    adjacency.clear();
+    for (size_t u = 0; u < nodes.size(); u++) {
+      cModule* mod = nodes[u];
+      for (int i = 0; i < mod->gateSize("out"); i++) {
+        cGate* connectedGate = mod->gate("out", i)->getNextGate();
+        if (connectedGate && connectedGate->getOwnerModule()) {
+          auto pos = positions.find(connectedGate->getOwnerModule()->getId());
+          if (pos != positions.end()) adjacency.push_back(pos->second);
+        }
+      }
+      offsets[u + 1] = adjacency.size();
+    }
+  }
+
+  int size() const { return nodes.size(); }
+  long links() const { return adjacency.size() / 2; }
+};
+
+#endif
@@ -0,0 +1,128 @@
+#include "MISProgressCollector.h"
+
+#include <iostream>
+
+#include "MISCheckpointer.h"
+
+Define_Module(MISProgressCollector);
+
+MISProgressCollector* MISProgressCollector::find(cModule* node) {
+  cModule* progress = node->getParentModule()->getSubmodule("progress");
+  if (!progress || progress->par("sampleInterval").doubleValue() <= 0) {
+    return nullptr;
+  }
+  return check_and_cast<MISProgressCollector*>(progress);
+}
+
+void MISProgressCollector::initialize() {
+  sampleInterval = par("sampleInterval").doubleValue();
+  sampleMsg = new cMessage("sample");
+  decidedNodes = 0;
+  activeEdges = 0;
+  messagesInFlight = 0;
+  samples = 0;
+  if (sampleInterval <= 0) return;
+
+  decidedFractionVector.setName("decidedFraction");
+  activeEdgesVector.setName("activeEdges");
+  messagesInFlightVector.setName("messagesInFlight");
+
+  graph.build(getParentModule());
+  decided.assign(graph.size(), 0);
+  activeEdges = graph.links();
+
+  // A resumed run gets its pending sample from the checkpointer
+  if (!MISCheckpointer::isResuming(this)) scheduleAt(simTime(), sampleMsg);
+}
+
+void MISProgressCollector::nodeDecided(cModule* node) {
+  auto pos = graph.positions.find(node->getId());
+  if (pos == graph.positions.end() || decided[pos->second]) return;
+
+  int u = pos->second;
+  decided[u] = 1;
+  decidedNodes++;
+
+  // Links are bidirectional, the first endpoint to decide deactivates them
+  for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+    if (!decided[graph.adjacency[e]]) activeEdges--;
+  }
+}
+
+void MISProgressCollector::handleMessage(cMessage* msg) {
+  if (msg == sampleMsg) {
+    recordSample();
+
+    // Stop once the network has converged and gone quiet
+    bool converged =
+        decidedNodes == (int)decided.size() && messagesInFlight == 0;
+    if (!converged && !getSimulation()->getFES()->isEmpty()) {
+      scheduleAt(simTime() + sampleInterval, sampleMsg);
+    }
+  } else {
+    EV_WARN << "Unknown message has been received!" << endl;
+    delete msg;
+  }
+}
+
+void MISProgressCollector::recordSample() {
+  double decidedFraction =
+      decided.empty() ? 1.0 : (double)decidedNodes / decided.size();
+  decidedFractionVector.record(decidedFraction);
+  activeEdgesVector.record(activeEdges);
+  messagesInFlightVector.record(messagesInFlight);
+  samples++;
+}
+
+void MISProgressCollector::saveState(CheckpointWriter& out) {
+  out.write((uint32_t)decided.size());
+  for (char flag : decided) out.write(flag);
+  out.write(decidedNodes);
+  out.write(activeEdges);
+  out.write(messagesInFlight);
+  out.write(samples);
+}
+
+void MISProgressCollector::loadState(CheckpointReader& in) {
+  uint32_t count;
+  in.read(count);
+  if (count != decided.size()) {
+    throw cRuntimeError("Checkpoint has %u nodes, network has %d", count,
+                        (int)decided.size());
+  }
+  for (char& flag : decided) in.read(flag);
+  in.read(decidedNodes);
+  in.read(activeEdges);
+  in.read(messagesInFlight);
+  in.read(samples);
+}
+
+int MISProgressCollector::selfMessageSlot(cMessage* msg) const {
+  return msg == sampleMsg ? 0 : -1;
+}
+
+void MISProgressCollector::restoreSelfMessage(int slot, simtime_t arrivalTime) {
+  Enter_Method_Silent();
+  if (slot != 0) {
+    throw cRuntimeError("Invalid self-message slot %d in checkpoint", slot);
+  }
+  scheduleAt(arrivalTime, sampleMsg);
+}
+
+void MISProgressCollector::restoreInFlight(cMessage* /*msg*/,
+                                           int /*gateIndex*/,
+                                           simtime_t /*arrivalTime*/) {
+  throw cRuntimeError("MISProgressCollector does not send messages");
+}
+
+void MISProgressCollector::finish() {
+  cancelAndDelete(sampleMsg);
+  if (sampleInterval <= 0) return;
+
+  // Final state, in case the run ended between two samples
+  recordSample();
+
+  recordScalar("progressSamples", samples);
+  recordScalar("finalDecidedFraction",
+               decided.empty() ? 1.0 : (double)decidedNodes / decided.size());
+}
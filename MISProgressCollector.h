@@ -0,0 +1,62 @@
+#ifndef __MISPROGRESSCOLLECTOR_H
+#define __MISPROGRESSCOLLECTOR_H
+
+#include <omnetpp.h>
+
+#include <vector>
+
+#include "Checkpoint.h"
+#include "MISGraph.h"
+
+using namespace omnetpp;
+
+/**
+ * Network-level convergence curves. Nodes report decisions and message
+ * sends/receipts to this one collector, which keeps running counters and
+ * samples them at a fixed sim-time interval into three output vectors, so
+ * no per-node vectors are needed.
+ */
+class MISProgressCollector : public cSimpleModule, public ICheckpointable {
+ private:
+  double sampleInterval;
+  cMessage* sampleMsg;
+  cOutVector decidedFractionVector;
+  cOutVector activeEdgesVector;
+  cOutVector messagesInFlightVector;
+
+  // Decisions deactivate exactly the links to still undecided neighbors
+  MISGraph graph;
+
+  // Shared counters
+  std::vector<char> decided;
+  int decidedNodes;
+  long activeEdges;
+  long messagesInFlight;
+  int samples;
+
+ public:
+  // Returns the collector of the node's network, nullptr if sampling is off
+  static MISProgressCollector* find(cModule* node);
+
+  void nodeDecided(cModule* node);
+  void messagesSent(int count) { messagesInFlight += count; }
+  void messageReceived() { messagesInFlight--; }
+
+  // Checkpoint support, see MISCheckpointer
+  virtual void saveState(CheckpointWriter& out) override;
+  virtual void loadState(CheckpointReader& in) override;
+  virtual int selfMessageSlot(cMessage* msg) const override;
+  virtual void restoreSelfMessage(int slot, simtime_t arrivalTime) override;
+  virtual void restoreInFlight(cMessage* msg, int gateIndex,
+                               simtime_t arrivalTime) override;
+
+ protected:
+  virtual void initialize() override;
+  virtual void handleMessage(cMessage* msg) override;
+  virtual void finish() override;
+
+ private:
+  void recordSample();
+};
+
+#endif
@@ -0,0 +1,74 @@
+#include "MISTraceRecorder.h"
+
+#include <iostream>
+
+Define_Module(MISTraceRecorder);
+
+static const char TRACE_MAGIC[8] = {'M', 'I', 'S', 'T', 'R', 'A', 'C', 'E'};
+static const uint32_t TRACE_VERSION = 1;
+
+MISTraceRecorder::~MISTraceRecorder() {
+  // Keep what was recorded if the run ends with an error
+  if (out.is_open() && !buffer.empty()) {
+    out.write(reinterpret_cast<const char*>(buffer.data()),
+              buffer.size() * sizeof(MISTraceRecord));
+  }
+}
+
+MISTraceRecorder* MISTraceRecorder::find(cModule* node) {
+  cModule* trace = node->getParentModule()->getSubmodule("trace");
+  if (!trace || trace->par("traceFile").stdstringValue().empty()) {
+    return nullptr;
+  }
+  return check_and_cast<MISTraceRecorder*>(trace);
+}
+
+void MISTraceRecorder::initialize() {
+  traceFile = par("traceFile").stdstringValue();
+  bufferRecords = par("bufferRecords").intValue();
+  recordsWritten = 0;
+  if (traceFile.empty()) return;
+
+  out.open(traceFile, std::ios::binary | std::ios::trunc);
+  if (!out) throw cRuntimeError("Cannot open trace file %s", traceFile.c_str());
+
+  // Header: magic, version, record size and the simtime scale exponent
+  int32_t scaleExp = SimTime::getScaleExp();
+  int32_t reserved = 0;
+  uint32_t recordSize = sizeof(MISTraceRecord);
+  out.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+  out.write(reinterpret_cast<const char*>(&TRACE_VERSION), sizeof(uint32_t));
+  out.write(reinterpret_cast<const char*>(&recordSize), sizeof(uint32_t));
+  out.write(reinterpret_cast<const char*>(&scaleExp), sizeof(int32_t));
+  out.write(reinterpret_cast<const char*>(&reserved), sizeof(int32_t));
+
+  buffer.reserve(bufferRecords);
+}
+
+void MISTraceRecorder::handleMessage(cMessage* msg) {
+  EV_WARN << "Unknown message has been received!" << endl;
+  delete msg;
+}
+
+void MISTraceRecorder::flush() {
+  if (buffer.empty()) return;
+
+  out.write(reinterpret_cast<const char*>(buffer.data()),
+            buffer.size() * sizeof(MISTraceRecord));
+  if (!out) throw cRuntimeError("Writing trace %s failed", traceFile.c_str());
+
+  recordsWritten += buffer.size();
+  buffer.clear();
+}
+
+void MISTraceRecorder::finish() {
+  if (!out.is_open()) return;
+
+  flush();
+  out.close();
+
+  EV << "Trace of " << recordsWritten << " records written to " << traceFile
+     << endl;
+
+  recordScalar("traceRecords", recordsWritten);
+}
@@ -0,0 +1,81 @@
+#ifndef __MISTRACERECORDER_H
+#define __MISTRACERECORDER_H
+
+#include <omnetpp.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace omnetpp;
+
+enum MISTraceEvent : uint8_t {
+  TRACE_PHASE_START,     // Node entered phase
+  TRACE_VALUE_SENT,      // value = own random value
+  TRACE_VALUE_RECEIVED,  // Accepted value of peer, peerPhase = sender phase
+  TRACE_JOIN,            // Node joined MIS, value = own random value
+  TRACE_TERMINATE,       // Node left because peer joined MIS
+  TRACE_STALE_DROP       // Dropped message of peerPhase, value = -1 for joins
+};
+
+/**
+ * Fixed-size trace record, 40 bytes in native byte order. The layout is
+ * mirrored by replay_trace.py, so keep both in sync.
+ */
+struct MISTraceRecord {
+  int64_t time;       // Raw simtime_t
+  double value;
+  int32_t nodeId;     // Recording node
+  int32_t peerId;     // Other node involved, -1 if none
+  int32_t phase;      // Phase of the recording node
+  int32_t peerPhase;  // Phase carried by the message, -1 if none
+  uint8_t event;
+  uint8_t padding[7];
+};
+
+static_assert(sizeof(MISTraceRecord) == 40, "Unexpected trace record size");
+
+/**
+ * Collects MIS protocol events from all sibling nodes into one binary trace
+ * file. Records are buffered in memory and written in large chunks, so
+ * tracing a large run costs far less than EV logging.
+ */
+class MISTraceRecorder : public cSimpleModule {
+ private:
+  std::string traceFile;
+  std::ofstream out;
+  std::vector<MISTraceRecord> buffer;
+  size_t bufferRecords;
+  long recordsWritten;
+
+ public:
+  virtual ~MISTraceRecorder();
+
+  // Returns the recorder of the node's network, nullptr if tracing is off
+  static MISTraceRecorder* find(cModule* node);
+
+  void record(MISTraceEvent event, int nodeId, int phase, int peerId = -1,
+              int peerPhase = -1, double value = 0) {
+    MISTraceRecord r{};
+    r.time = simTime().raw();
+    r.value = value;
+    r.nodeId = nodeId;
+    r.peerId = peerId;
+    r.phase = phase;
+    r.peerPhase = peerPhase;
+    r.event = event;
+    buffer.push_back(r);
+    if (buffer.size() >= bufferRecords) flush();
+  }
+
+ protected:
+  virtual void initialize() override;
+  virtual void handleMessage(cMessage* msg) override;
+  virtual void finish() override;
+
+ private:
+  void flush();
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include "MISVerifier.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+Define_Module(MISVerifier);
+
+void MISVerifier::initialize() {
+  failOnViolation = par("failOnViolation").boolValue();
+  parallelThreshold = par("parallelThreshold").intValue();
+  threads = par("threads").intValue();
+}
+
+void MISVerifier::handleMessage(cMessage* msg) {
+  EV_WARN << "Unknown message has been received!" << endl;
+  delete msg;
+}
+
+/**
+ * Counts links between two MIS nodes and nodes that are neither in MIS nor
+ * next to one. Links are bidirectional, so each one is counted from its
+ * lower end only.
+ */
+void MISVerifier::checkRange(int begin, int end, long& violations,
+                             long& uncovered) const {
+  violations = 0;
+  uncovered = 0;
+  for (int u = begin; u < end; u++) {
+    bool covered = inMIS[u];
+    for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+      int v = graph.adjacency[e];
+      if (inMIS[v]) {
+        covered = true;
+        if (inMIS[u] && u < v) violations++;
+      }
+    }
+    if (!covered) uncovered++;
+  }
+}
+
+void MISVerifier::finish() {
+  // Final MIS membership of every node of the connection graph
+  graph.build(getParentModule());
+  int numNodes = graph.size();
+  inMIS.assign(numNodes, 0);
+  for (int u = 0; u < numNodes; u++) {
+    inMIS[u] = dynamic_cast<IMISMember*>(graph.nodes[u])->isInMIS();
+  }
+
+  int workers = 1;
+  if (numNodes >= parallelThreshold) {
+    workers = threads > 0 ? threads : std::thread::hardware_concurrency();
+    workers = std::max(1, std::min(workers, numNodes));
+  }
+
+  // Every worker checks a contiguous range of nodes on the shared arrays
+  std::vector<long> violations(workers, 0);
+  std::vector<long> uncovered(workers, 0);
+  std::vector<std::thread> pool;
+  for (int w = 1; w < workers; w++) {
+    pool.emplace_back(&MISVerifier::checkRange, this,
+                      (int)((long)numNodes * w / workers),
+                      (int)((long)numNodes * (w + 1) / workers),
+                      std::ref(violations[w]), std::ref(uncovered[w]));
+  }
+  checkRange(0, numNodes / workers, violations[0], uncovered[0]);
+  for (std::thread& t : pool) t.join();
+
+  long totalViolations = 0;
+  long totalUncovered = 0;
+  for (int w = 0; w < workers; w++) {
+    totalViolations += violations[w];
+    totalUncovered += uncovered[w];
+  }
+  long misSize = std::count(inMIS.begin(), inMIS.end(), 1);
+
+  EV << "MIS verification of " << numNodes << " nodes and "
+     << graph.links() << " links with " << workers << " threads: "
+     << totalViolations << " independence violations, " << totalUncovered
+     << " uncovered nodes" << endl;
+
+  recordScalar("verifiedNodes", numNodes);
+  recordScalar("verifiedLinks", graph.links());
+  recordScalar("misSize", misSize);
+  recordScalar("independenceViolations", totalViolations);
+  recordScalar("uncoveredNodes", totalUncovered);
+
+  if (failOnViolation && (totalViolations > 0 || totalUncovered > 0)) {
+    throw cRuntimeError("Invalid MIS: %ld independence violations, "
+                        "%ld uncovered nodes",
+                        totalViolations, totalUncovered);
+  }
+}
@@ -0,0 +1,36 @@
+#ifndef __MISVERIFIER_H
+#define __MISVERIFIER_H
+
+#include <omnetpp.h>
+
+#include <vector>
+
+#include "MISGraph.h"
+
+using namespace omnetpp;
+
+/**
+ * Checks at the end of the run that the sibling nodes in MIS form an
+ * independent and maximal set of the actual connection graph. The graph is
+ * read once into adjacency arrays and checked in O(V+E), split over several
+ * threads for large graphs.
+ */
+class MISVerifier : public cSimpleModule {
+ private:
+  bool failOnViolation;
+  int parallelThreshold;
+  int threads;
+
+  MISGraph graph;
+  std::vector<char> inMIS;
+
+ protected:
+  virtual void initialize() override;
+  virtual void handleMessage(cMessage* msg) override;
+  virtual void finish() override;
+
+ private:
+  void checkRange(int begin, int end, long& violations, long& uncovered) const;
+};
+
+#endif
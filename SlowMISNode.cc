@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+#include "MISCheckpointer.h"
+
 Define_Module(SlowMISNode);
 
 void SlowMISNode::initialize() {
@@ -19,6 +21,7 @@ void SlowMISNode::initialize() {
   // Register signals
   msgOverheadSignal = registerSignal("msgOverhead");
   convergenceTimeSignal = registerSignal("convergenceTime");
+  progress = MISProgressCollector::find(this);
 
   // Initialize timing parameters
   initialStartDelay = par("initialStartDelay").doubleValue();
@@ -44,13 +47,18 @@ void SlowMISNode::initialize() {
   getDisplayString().setTagArg("i", 1, "blue");
   getDisplayString().setTagArg("i", 2, "35");
 
-  // Start the algorithm with uniform delay
-  scheduleAt(simTime() + uniform(0, initialStartDelay), startAlgorithmMsg);
+  // Start the algorithm with uniform delay, unless the checkpointer restores
+  // the pending events of an earlier run
+  if (!MISCheckpointer::isResuming(this)) {
+    scheduleAt(simTime() + uniform(0, initialStartDelay), startAlgorithmMsg);
+  }
 
   EV << "SlowMISNode " << nodeId << " initialized" << endl;
 }
 
 void SlowMISNode::handleMessage(cMessage* msg) {
+  if (progress && !msg->isSelfMessage()) progress->messageReceived();
+
   if (terminated && !msg->isSelfMessage()) {
     // Delete messages from others that are sent after we terminated.
     delete msg;
@@ -152,6 +160,7 @@ void SlowMISNode::terminate() {
   if (terminated) return;
 
   terminated = true;
+  if (progress) progress->nodeDecided(this);
 
   if (algorithmEndTime.isZero()) {
     algorithmEndTime = simTime();
@@ -216,6 +225,7 @@ void SlowMISNode::broadcastToNeighbors(cMessage* msg) {
   for (int i = 0; i < gateSize("out"); i++) {
     if (gate("out", i)->isConnected()) {
       send(msg->dup(), "out", i);
+      if (progress) progress->messagesSent(1);
     }
   }
   delete msg;
@@ -236,9 +246,57 @@ void SlowMISNode::broadcastToLowerNeighbors(cMessage* msg) {
     }
   }
   totalMessagesSent += sentCount;
+  if (progress) progress->messagesSent(sentCount);
   delete msg;
 }
 
+void SlowMISNode::saveState(CheckpointWriter& out) {
+  out.write(inMIS);
+  out.write(terminated);
+  out.write(neighborDecisions);
+  out.write(totalMessagesSent);
+  out.write(totalMessagesReceived);
+  out.write(controlMessagesReceived);
+  out.write(algorithmEndTime);
+}
+
+void SlowMISNode::loadState(CheckpointReader& in) {
+  in.read(inMIS);
+  in.read(terminated);
+  in.read(neighborDecisions);
+  in.read(totalMessagesSent);
+  in.read(totalMessagesReceived);
+  in.read(controlMessagesReceived);
+  in.read(algorithmEndTime);
+
+  if (inMIS) {
+    getDisplayString().setTagArg("i", 0, "device/server");
+    getDisplayString().setTagArg("i", 1, "green");
+    getDisplayString().setTagArg("i", 2, "50");
+  } else if (terminated) {
+    getDisplayString().setTagArg("i", 0, "device/pc");
+    getDisplayString().setTagArg("i", 1, "red");
+    getDisplayString().setTagArg("i", 2, "30");
+  }
+}
+
+int SlowMISNode::selfMessageSlot(cMessage* msg) const {
+  return msg == startAlgorithmMsg ? 0 : -1;
+}
+
+void SlowMISNode::restoreSelfMessage(int slot, simtime_t arrivalTime) {
+  Enter_Method_Silent();
+  if (slot != 0) {
+    throw cRuntimeError("Invalid self-message slot %d in checkpoint", slot);
+  }
+  scheduleAt(arrivalTime, startAlgorithmMsg);
+}
+
+void SlowMISNode::restoreInFlight(cMessage* msg, int gateIndex,
+                                  simtime_t arrivalTime) {
+  redeliverInFlight(msg, gate("out", gateIndex), arrivalTime);
+}
+
 void SlowMISNode::finish() {
   // Cancel and delete self messages
   if (startAlgorithmMsg) {
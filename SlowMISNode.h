@@ -6,11 +6,16 @@
 #include <map>
 #include <set>
 
+#include "Checkpoint.h"
+#include "MISProgressCollector.h"
+#include "MISGraph.h"
 #include "message_m.h"
 
 using namespace omnetpp;
 
-class SlowMISNode : public cSimpleModule {
+class SlowMISNode : public cSimpleModule,
+                    public ICheckpointable,
+                    public IMISMember {
  public:
   enum Decision { JOIN_MIS, TERMINATE, NO_DECISION };
 
@@ -41,6 +46,9 @@ class SlowMISNode : public cSimpleModule {
   simsignal_t msgOverheadSignal;
   simsignal_t convergenceTimeSignal;
 
+  // Network-level progress counters, nullptr unless sampling is enabled
+  MISProgressCollector* progress;
+
   // Methods
   void startNeighborDiscovery();
   void finishNeighborDiscovery();
@@ -58,6 +66,18 @@ class SlowMISNode : public cSimpleModule {
   virtual void initialize() override;
   virtual void handleMessage(cMessage* msg) override;
   virtual void finish() override;
+
+ public:
+  // Checkpoint support, see MISCheckpointer
+  virtual void saveState(CheckpointWriter& out) override;
+  virtual void loadState(CheckpointReader& in) override;
+  virtual int selfMessageSlot(cMessage* msg) const override;
+  virtual void restoreSelfMessage(int slot, simtime_t arrivalTime) override;
+  virtual void restoreInFlight(cMessage* msg, int gateIndex,
+                               simtime_t arrivalTime) override;
+
+  // Final MIS membership, see MISVerifier
+  virtual bool isInMIS() const override { return inMIS; }
 };
 
 #endif
\ No newline at end of file
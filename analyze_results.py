@@ -24,6 +24,8 @@ plt.rcParams['xtick.labelsize'] = 10
 plt.rcParams['ytick.labelsize'] = 10
 plt.rcParams['legend.fontsize'] = 10
 
+ALGORITHMS = ['FastMIS', 'SlowMIS', 'ColoringMIS']
+
 def parse_sca_file(filename):
     """Parse OMNeT++ .sca file and extract statistics"""
     data = {
@@ -124,11 +126,15 @@ def aggregate_metrics(sca_files, pattern):
         neighbor_counts = [node.get('initialNeighborCount', 0) for node in data['nodes'].values()]
         avg_neighbors = np.mean(neighbor_counts) if neighbor_counts else 0
         
-        # Cluster size metrics (MIS node degree)
+        # Cluster size metrics (formed cluster size, or MIS node degree when
+        # the run has no cluster formation stage)
         mis_cluster_sizes = []
         for node_id, node_data in data['nodes'].items():
             if node_data.get('inMIS', 0) == 1:
-                mis_cluster_sizes.append(node_data.get('initialNeighborCount', 0) + 1)  # +1 for the node itself
+                if 'clusterSize' in node_data:
+                    mis_cluster_sizes.append(node_data['clusterSize'])
+                else:
+                    mis_cluster_sizes.append(node_data.get('initialNeighborCount', 0) + 1)  # +1 for the node itself
         
         avg_cluster_size = np.mean(mis_cluster_sizes) if mis_cluster_sizes else 0
         cluster_size_std = np.std(mis_cluster_sizes) if len(mis_cluster_sizes) > 1 else 0
@@ -193,7 +199,7 @@ def plot_comparison(df, metric, ylabel, title, filename):
     fig, ax = plt.subplots(figsize=(10, 6))
     
     # Group by algorithm type
-    df['algorithm'] = df['config'].apply(lambda x: 'FastMIS' if 'FastMIS' in x else 'SlowMIS')
+    df['algorithm'] = df['config'].apply(lambda x: next((a for a in ALGORITHMS if a in x), 'SlowMIS'))
     
     algorithms = df['algorithm'].unique()
     x = np.arange(len(algorithms))
@@ -294,7 +300,7 @@ def main():
     output_dir.mkdir(exist_ok=True)
     
     # Analyze each algorithm separately
-    for algo in ['FastMIS', 'SlowMIS']:
+    for algo in ALGORITHMS:
         print(f"\n{algo} Analysis:")
         print("-" * 60)
         
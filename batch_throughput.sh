@@ -0,0 +1,104 @@
+#!/bin/bash
+
+# Compares replication throughput of batched runs against one run per replication
+# Usage: ./batch_throughput.sh [replications]
+# Example: ./batch_throughput.sh 100
+#
+# For each deterministic topology, runs the same number of FastMIS replications
+# once as separate runs (-r 0..K-1) and once as a single batched run sharing the
+# topology, and reports replications per second for both. The batched path is
+# a phase-synchronous model of FastMIS, so the speedup compares that model
+# against the event-level simulation rather than measuring topology reuse alone.
+
+# Default values
+DEFAULT_REPLICATIONS=100
+
+# Per-run configs and their batched counterparts
+CONFIGS=(FastMIS-Complete FastMIS-Complete-Large FastMIS-Grid-Small FastMIS-Grid-Medium)
+BATCH_CONFIGS=(FastMIS-Batch-Complete FastMIS-Batch-Complete-Large FastMIS-Batch-Grid-Small FastMIS-Batch-Grid-Medium)
+
+# Batched means must be within this relative distance of the per-run means
+TOLERANCE=0.10
+
+# Parse command line arguments
+REPLICATIONS=${1:-$DEFAULT_REPLICATIONS}
+
+RESULTS_DIR=$(mktemp -d)
+trap 'rm -rf "$RESULTS_DIR"' EXIT
+
+# Mean MIS size and phase count over the per-run .sca files in a directory.
+# FastMISNode starts at phase 1 and enters its first real phase as 2.
+per_run_means() {
+    awk '
+        FNR == 1 { if (mis_count) { mis_sum += mis; phase_sum += max_phase - 1 }
+                   mis_count++; mis = 0; max_phase = 0 }
+        $1 == "scalar" && $2 ~ /node\[/ && $3 == "inMIS" { mis += $4 }
+        $1 == "scalar" && $2 ~ /node\[/ && $3 == "phase" && $4 > max_phase { max_phase = $4 }
+        END { mis_sum += mis; phase_sum += max_phase - 1
+              if (mis_count) printf "%f %f\n", mis_sum / mis_count, phase_sum / mis_count }
+    ' "$1"/*.sca
+}
+
+# Mean MIS size and phase count recorded by the batch runner
+batch_means() {
+    awk '
+        $1 == "statistic" { name = $3 }
+        $1 == "field" && $2 == "mean" && name == "misSize" { mis = $3 }
+        $1 == "field" && $2 == "mean" && name == "phases" { phases = $3 }
+        END { printf "%f %f\n", mis, phases }
+    ' "$1"/*.sca
+}
+
+# Succeeds when two means are within TOLERANCE of each other
+means_agree() {
+    echo "d = $1 - $2; if (d < 0) d = -d; d <= $TOLERANCE * $1" | bc -l | grep -q 1
+}
+
+echo "Measuring throughput with $REPLICATIONS replications per topology"
+echo ""
+printf "%-22s %14s %14s %9s %15s %15s\n" "Topology" "per-run rep/s" "batched rep/s" "speedup" \
+    "MIS size" "phases"
+
+for i in "${!CONFIGS[@]}"; do
+    config="${CONFIGS[$i]}"
+    batch_config="${BATCH_CONFIGS[$i]}"
+
+    # Current path: every replication rebuilds the network. Cluster formation
+    # is off so both paths measure only the MIS stage.
+    start=$(date +%s.%N)
+    ./demo -u Cmdenv -c "$config" -r "0..$((REPLICATIONS - 1))" \
+        --*.node[*].clusteringEnabled=false --result-dir="$RESULTS_DIR/$config" > /dev/null 2>&1
+    end=$(date +%s.%N)
+    per_run_rate=$(echo "$REPLICATIONS / ($end - $start)" | bc -l)
+
+    # Batched path: one network, all replications inside
+    start=$(date +%s.%N)
+    ./demo -u Cmdenv -c "$batch_config" --*.runner.replications="$REPLICATIONS" \
+        --result-dir="$RESULTS_DIR/$batch_config" > /dev/null 2>&1
+    end=$(date +%s.%N)
+    batch_rate=$(echo "$REPLICATIONS / ($end - $start)" | bc -l)
+
+    # Only report a speedup when both paths sample the same distribution
+    read -r run_mis run_phases <<< "$(per_run_means "$RESULTS_DIR/$config")"
+    read -r batch_mis batch_phases <<< "$(batch_means "$RESULTS_DIR/$batch_config")"
+    if means_agree "$run_mis" "$batch_mis" && means_agree "$run_phases" "$batch_phases"; then
+        speedup=$(printf "%8.1fx" "$(echo "$batch_rate / $per_run_rate" | bc -l)")
+    else
+        speedup="      n/a"
+        mismatch=1
+    fi
+    printf "%-22s %14.1f %14.1f %9s %7.2f/%-7.2f %7.2f/%-7.2f\n" "$config" "$per_run_rate" "$batch_rate" \
+        "$speedup" "$run_mis" "$batch_mis" "$run_phases" "$batch_phases"
+done
+
+if [ -n "$mismatch" ]; then
+    echo ""
+    echo "Warning: batched mean MIS size or phase count differs from the per-run"
+    echo "         configs by more than $(echo "$TOLERANCE * 100" | bc)%, speedup not reported (n/a)."
+fi
+
+echo ""
+echo "Note: batched runs use a phase-synchronous FastMIS model, so the speedup"
+echo "      compares that model against the event-level simulation and does not"
+echo "      come from topology reuse alone. MIS size and phase columns show"
+echo "      per-run/batched means."
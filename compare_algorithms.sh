@@ -20,6 +20,11 @@ echo "----------------------------------------"
 ./demo -u Cmdenv -c FastMIS-Grid-Small -r 0 2>&1 | grep "INFO:" | head -10
 echo ""
 
+echo "3. ColoringMIS (deterministic coloring + color sweeps)"
+echo "----------------------------------------"
+./demo -u Cmdenv -c ColoringMIS-Grid-Small -r 0 2>&1 | grep "INFO:" | head -10
+echo ""
+
 echo "================================================"
 echo "Comparison complete!"
 echo "================================================"
@@ -27,3 +32,4 @@ echo ""
 echo "Key observations:"
 echo "- SlowMIS: Deterministic, depends on node IDs"
 echo "- FastMIS: Randomized phases, O(log Δ · log log Δ)"
+echo "- ColoringMIS: Deterministic rounds, O(Δ log Δ + log* n)"
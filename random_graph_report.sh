@@ -8,6 +8,8 @@
 # Tests multiple combinations of node counts and edge probabilities:
 # - Nodes: 100, 1000, 2000
 # - Edge Probabilities: 0.2, 0.5, 0.8
+#
+# Cluster formation is disabled so that SimTime covers the MIS stage only.
 
 # Default values
 DEFAULT_RUNS="0..10"
@@ -36,7 +38,7 @@ for NODES in "${NODE_COUNTS[@]}"; do
     for EDGE_PROB in "${EDGE_PROBS[@]}"; do
         echo "=== Testing: $NODES nodes, edge probability $EDGE_PROB ==="
         
-        for algo in FastMIS SlowMIS; do
+        for algo in FastMIS SlowMIS ColoringMIS; do
             config="${algo}-RandomGraph"
             echo "  Running $config..."
             
@@ -44,6 +46,7 @@ for NODES in "${NODE_COUNTS[@]}"; do
             OUTPUT=$(./demo -c "$config" -u Cmdenv \
                 --*.numNodes="$NODES" \
                 --*.edgeProbability="$EDGE_PROB" \
+                --*.node[*].clusteringEnabled=false \
                 -r "$RUNS" 2>&1)
             
             # Parse results
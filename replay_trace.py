@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""
+Offline replay of binary MIS event traces written by MISTraceRecorder
+Rebuilds per-node timelines and per-phase random value orderings without
+re-running the simulation
+"""
+
+import argparse
+import struct
+import sys
+from collections import Counter
+
+# Must match MISTraceRecorder.h
+HEADER = struct.Struct('<8sIIii')
+RECORD = struct.Struct('<qdiiiiB7x')
+MAGIC = b'MISTRACE'
+VERSION = 1
+
+EVENTS = ['PHASE_START', 'VALUE_SENT', 'VALUE_RECEIVED', 'JOIN', 'TERMINATE',
+          'STALE_DROP']
+PHASE_START, VALUE_SENT, VALUE_RECEIVED, JOIN, TERMINATE, STALE_DROP = range(6)
+
+def read_trace(filename):
+    """Return the list of (time, value, node, peer, phase, peer_phase, event)"""
+    with open(filename, 'rb') as f:
+        data = f.read()
+
+    if len(data) < HEADER.size:
+        print(f"Error: {filename} is too short for a trace header")
+        sys.exit(1)
+    magic, version, record_size, scale_exp, _ = HEADER.unpack_from(data)
+    if magic != MAGIC or version != VERSION or record_size != RECORD.size:
+        print(f"Error: {filename} is not a version {VERSION} MIS trace")
+        sys.exit(1)
+
+    body = memoryview(data)[HEADER.size:]
+    usable = len(body) - len(body) % RECORD.size
+    scale = 10.0 ** scale_exp
+    return [(raw * scale, value, node, peer, phase, peer_phase, event)
+            for raw, value, node, peer, phase, peer_phase, event
+            in RECORD.iter_unpack(body[:usable])]
+
+def describe(record):
+    """One timeline line for a record"""
+    time, value, node, peer, phase, peer_phase, event = record
+    name = EVENTS[event] if event < len(EVENTS) else f"UNKNOWN({event})"
+    line = f"t={time:<12.6f} phase {phase:<4} {name:<15}"
+    if event in (VALUE_SENT, JOIN):
+        line += f" value {value:.6f}"
+    elif event == VALUE_RECEIVED:
+        line += f" value {value:.6f} from {peer}"
+    elif event == TERMINATE:
+        line += f" neighbor {peer} joined MIS"
+    elif event == STALE_DROP:
+        kind = 'join notification' if value < 0 else f"value {value:.6f}"
+        line += f" {kind} from {peer} of phase {peer_phase}"
+    return line.rstrip()
+
+def print_summary(records):
+    counts = Counter(record[6] for record in records)
+    nodes = {record[2] for record in records}
+    joined = sorted(record[2] for record in records if record[6] == JOIN)
+    terminated = {record[2] for record in records if record[6] == TERMINATE}
+    undecided = sorted(nodes - set(joined) - terminated)
+    last_phase = max((record[4] for record in records), default=0)
+
+    print(f"Records: {len(records)}, nodes: {len(nodes)}, last phase: {last_phase}")
+    for event, name in enumerate(EVENTS):
+        print(f"  {name:<15} {counts.get(event, 0)}")
+    print(f"In MIS ({len(joined)}): {joined}")
+    print(f"Terminated by a neighbor: {len(terminated)}")
+    if undecided:
+        print(f"Never decided ({len(undecided)}): {undecided}")
+
+def print_timeline(records, node):
+    timeline = [record for record in records if record[2] == node]
+    if not timeline:
+        print(f"Node {node} has no trace records")
+        return
+    print(f"Timeline of node {node}:")
+    for record in timeline:
+        print("  " + describe(record))
+
+def print_phase_ordering(records, node, phase):
+    """Sorted values of a node's phase, as logPhaseEnd() prints them"""
+    values = []
+    for time, value, rec_node, peer, rec_phase, _, event in records:
+        if rec_node != node or rec_phase != phase:
+            continue
+        if event == VALUE_SENT:
+            values.append((value, node))
+        elif event == VALUE_RECEIVED:
+            values.append((value, peer))
+
+    # Neighbors that decided in this phase drop out of the comparison
+    phase_end = min((record[0] for record in records
+                     if record[2] == node and record[6] == PHASE_START
+                     and record[4] > phase), default=float('inf'))
+    left = {record[2] for record in records
+            if record[6] in (JOIN, TERMINATE) and record[0] <= phase_end}
+
+    entries = []
+    for value, peer in sorted(values):
+        if peer == node:
+            entries.append(f">>>{value:.6f} (SELF)<<<")
+        else:
+            entries.append(f"{value:.6f} ({peer}{', left' if peer in left else ''})")
+    print(f"Node {node} phase {phase} values (sorted) [{', '.join(entries)}]")
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Replay a binary MIS event trace')
+    parser.add_argument('trace', help='.mistrace file written by MISTraceRecorder')
+    parser.add_argument('--node', type=int, help='print the timeline of this node')
+    parser.add_argument('--phase', type=int,
+                        help='with --node, print the sorted values of this phase')
+    parser.add_argument('--all-phases', action='store_true',
+                        help='with --node, print the sorted values of every phase')
+    args = parser.parse_args()
+
+    records = read_trace(args.trace)
+
+    if args.node is None:
+        print_summary(records)
+    elif args.phase is not None:
+        print_phase_ordering(records, args.node, args.phase)
+    else:
+        print_timeline(records, args.node)
+        if args.all_phases:
+            phases = sorted({record[4] for record in records
+                             if record[2] == args.node and record[6] == VALUE_SENT})
+            for phase in phases:
+                print_phase_ordering(records, args.node, phase)
+
+if __name__ == "__main__":
+    main()
@@ -12,7 +12,11 @@ echo "========================================================================="
 echo ""
 
 # Configuration
-RUNS="0..29"  # 30 runs for good confidence intervals
+# Each config runs until the 95% CI half-width of MIS size, convergence time
+# and message overhead is within TARGET_CI of the mean (sequential stopping)
+MIN_RUNS=5
+MAX_RUNS=100  # Must not exceed the configs' repeat count
+TARGET_CI=0.05
 RESULTS_DIR="results_comprehensive"
 
 # Create results directory
@@ -26,24 +30,27 @@ completed_tests=0
 run_simulation() {
     local config=$1
     local description=$2
+    local extra_args=$3
     
     total_tests=$((total_tests + 1))
     
+    # Parameterized runs of the same config need distinct result file names
+    local tag="$config"
+    if [ -n "$extra_args" ]; then
+        tag="$config-$(echo "$extra_args" | sed 's/--\*\.//g; s/[ =]/_/g')"
+    fi
+    
     echo ""
     echo "-------------------------------------------------------------------------"
     echo "Test $total_tests: $description"
     echo "Config: $config"
-    echo "Runs: $RUNS"
+    echo "Runs: $MIN_RUNS..$MAX_RUNS, target relative CI half-width $TARGET_CI"
     echo "-------------------------------------------------------------------------"
     
-    ./demo -u Cmdenv -c "$config" -r "$RUNS" 2>&1 | grep -E "(INFO:|Run #|Simulation completed|Error)"
-    
-    # Move result files
-    for file in results/*.sca results/*.vec; do
-        if [ -f "$file" ]; then
-            mv "$file" "$RESULTS_DIR/"
-        fi
-    done
+    python3 sequential_runs.py "$config" \
+        --min-runs "$MIN_RUNS" --max-runs "$MAX_RUNS" --target "$TARGET_CI" \
+        --results-dir "$RESULTS_DIR" --tag "$tag" \
+        -- $extra_args 2>&1 | grep -E "(Run #|Stopped|Error)"
     
     completed_tests=$((completed_tests + 1))
     echo "✓ Completed test $completed_tests/$total_tests"
@@ -150,6 +157,7 @@ echo ""
 echo "Summary:"
 echo "  Total tests completed: $completed_tests"
 echo "  Results directory: $RESULTS_DIR/"
+echo "  Runs per config: $RESULTS_DIR/sequential_stopping.csv"
 echo "  Completion time: $(date)"
 echo ""
 echo "Next steps:"
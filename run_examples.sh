@@ -28,6 +28,13 @@ echo "  Medium (50 nodes):  SlowMIS-Random-Medium-{Sparse|Medium|Dense}"
 echo "  Large (100 nodes):  SlowMIS-Random-Large-{Sparse|Medium|Dense}"
 echo "    Sparse: p=0.2, Medium: p=0.5, Dense: p=0.8"
 echo ""
+echo "Coloring MIS Algorithm (Deterministic - coloring based):"
+echo "  ColoringMIS-Complete      - Complete graph with 6 nodes"
+echo "  ColoringMIS-Complete-Large - Complete graph with 10 nodes"
+echo "  ColoringMIS-Grid-Small    - 3x3 grid topology"
+echo "  ColoringMIS-Grid-Medium   - 4x4 grid topology"
+echo "  ColoringMIS-Fast          - Fast execution with shorter rounds"
+echo ""
 echo "Ring Algorithm (original):"
 echo "  SimpleRing            - Ring with 4 nodes"
 echo "  MediumRing            - Ring with 6 nodes" 
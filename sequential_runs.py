@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""
+Sequential-stopping replication control for MIS simulation campaigns
+Runs one replication at a time and stops a configuration once the relative
+confidence interval half-width of every tracked metric reaches the target
+"""
+
+import argparse
+import subprocess
+import sys
+from pathlib import Path
+
+from analyze_results import aggregate_metrics, calculate_confidence_interval
+
+# Per-run metrics (columns of aggregate_metrics) that must be estimated precisely
+TRACKED_METRICS = ['mis_nodes', 'max_convergence_time', 'total_message_overhead']
+
+def relative_half_width(values, confidence):
+    """Return the CI half-width relative to the mean of the values"""
+    mean, _, ci_high = calculate_confidence_interval(values, confidence)
+    half_width = ci_high - mean
+    if mean == 0:
+        return 0.0 if half_width == 0 else float('inf')
+    return half_width / abs(mean)
+
+def run_replication(args, run, sca_file):
+    """Run a single replication of the configuration into sca_file, exit on failure"""
+    command = [args.demo, '-u', 'Cmdenv', '-c', args.config, '-r', str(run),
+               f'--output-scalar-file={sca_file}'] + args.extra
+    result = subprocess.run(command, capture_output=True, text=True)
+    for line in result.stdout.splitlines():
+        if 'Error' in line or (args.verbose and 'INFO:' in line):
+            print(line)
+    if result.returncode != 0:
+        print(f"Error: run #{run} of {args.config} exited with code {result.returncode}")
+        if result.stderr.strip():
+            print(result.stderr.rstrip(), file=sys.stderr)
+        sys.exit(1)
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Run replications until the confidence intervals are tight enough')
+    parser.add_argument('config', help='omnetpp.ini configuration name')
+    parser.add_argument('--min-runs', type=int, default=5,
+                        help='replications to run before checking the stopping rule')
+    parser.add_argument('--max-runs', type=int, default=100,
+                        help='upper bound on replications (must not exceed the config\'s repeat)')
+    parser.add_argument('--target', type=float, default=0.05,
+                        help='target relative CI half-width, e.g. 0.05 for +-5%%')
+    parser.add_argument('--confidence', type=float, default=0.95,
+                        help='confidence level of the intervals')
+    parser.add_argument('--results-dir', default='results',
+                        help='directory for the .sca files')
+    parser.add_argument('--tag', default=None,
+                        help='file name prefix, defaults to the config name')
+    parser.add_argument('--demo', default='./demo', help='simulation executable')
+    parser.add_argument('--verbose', action='store_true', help='print INFO lines')
+
+    # Everything after -- goes to the simulation, e.g. -- --*.numNodes=200
+    argv = sys.argv[1:]
+    extra = []
+    if '--' in argv:
+        split = argv.index('--')
+        argv, extra = argv[:split], argv[split + 1:]
+    args = parser.parse_args(argv)
+    args.extra = extra
+
+    if args.min_runs < 2 or args.max_runs < args.min_runs:
+        print("Error: need 2 <= min-runs <= max-runs")
+        sys.exit(1)
+
+    results_dir = Path(args.results_dir)
+    results_dir.mkdir(parents=True, exist_ok=True)
+    tag = args.tag or args.config
+
+    history = {metric: [] for metric in TRACKED_METRICS}
+    reason = f"reached max runs ({args.max_runs})"
+    runs = 0
+
+    for run in range(args.max_runs):
+        sca_file = results_dir / f"{tag}-#{run}.sca"
+        run_replication(args, run, sca_file)
+        if not sca_file.exists():
+            print(f"Error: run #{run} of {args.config} wrote no {sca_file}")
+            sys.exit(1)
+        runs += 1
+
+        df = aggregate_metrics([sca_file], '')
+        for metric in TRACKED_METRICS:
+            history[metric].append(df[metric].iloc[0])
+
+        if runs < args.min_runs:
+            continue
+
+        widths = {metric: relative_half_width(history[metric], args.confidence)
+                  for metric in TRACKED_METRICS}
+        print(f"Run #{run}: " + ", ".join(f"{metric} +-{width:.1%}"
+                                          for metric, width in widths.items()))
+
+        if all(width <= args.target for width in widths.values()):
+            reason = f"all relative CI half-widths <= {args.target:.1%}"
+            break
+
+    print(f"Stopped {tag} after {runs} runs: {reason}")
+
+    # Keep a record of how many replications every configuration needed
+    summary_file = results_dir / 'sequential_stopping.csv'
+    new_file = not summary_file.exists()
+    with open(summary_file, 'a') as f:
+        if new_file:
+            f.write('tag,config,runs,' + ','.join(
+                f"{metric}_mean,{metric}_rel_ci" for metric in TRACKED_METRICS) + '\n')
+        values = []
+        for metric in TRACKED_METRICS:
+            mean, _, _ = calculate_confidence_interval(history[metric], args.confidence)
+            values.append(f"{mean:.4f},{relative_half_width(history[metric], args.confidence):.4f}")
+        f.write(f"{tag},{args.config},{runs}," + ','.join(values) + '\n')
+
+if __name__ == "__main__":
+    main()